@@ -39,11 +39,14 @@ SOURCES += \
     src/mixnode.cpp \
     src/mix.cpp \
     src/preview3d.cpp \
+    src/thumbnail.cpp \
+    src/components.cpp \
     src/albedonode.cpp \
     src/albedo.cpp \
     src/metalnode.cpp \
     src/onechanel.cpp \
     src/roughnode.cpp \
+    src/heightnode.cpp \
     src/normalmapnode.cpp \
     src/normalmap.cpp \
     src/normalnode.cpp \
@@ -78,9 +81,13 @@ SOURCES += \
     src/brightnesscontrast.cpp \
     src/thresholdnode.cpp \
     src/threshold.cpp \
-    src/cubicbezier.cpp \
+    src/edgebatch.cpp \
     src/cutline.cpp \
-    src/frame.cpp
+    src/spatialindex.cpp \
+    src/shaderwarmup.cpp \
+    src/frame.cpp \
+    src/uvchain.cpp \
+    src/hash.cpp
 
 RESOURCES += src/qml.qrc
 
@@ -112,11 +119,14 @@ HEADERS += \
     src/mixnode.h \
     src/mix.h \
     src/preview3d.h \
+    src/thumbnail.h \
+    src/components.h \
     src/albedonode.h \
     src/albedo.h \
     src/metalnode.h \
     src/onechanel.h \
     src/roughnode.h \
+    src/heightnode.h \
     src/normalmapnode.h \
     src/normalmap.h \
     src/normalnode.h \
@@ -151,19 +161,29 @@ HEADERS += \
     src/brightnesscontrast.h \
     src/thresholdnode.h \
     src/threshold.h \
-    src/cubicbezier.h \
+    src/edgebatch.h \
     src/cutline.h \
-    src/frame.h
+    src/spatialindex.h \
+    src/shaderwarmup.h \
+    src/frame.h \
+    src/uvchain.h \
+    src/hash.h
 
 DISTFILES += \
     shaders/noise.vert \
     shaders/noise.frag \
+    shaders/hash.glsl \
+    shaders/noiselayers.frag \
     shaders/texture.vert \
     shaders/texture.frag \
     shaders/texmatrix.vert \
     shaders/mix.frag \
     shaders/pbr.vert \
     shaders/pbr.frag \
+    shaders/pbrtess.vert \
+    shaders/pbr.tesc \
+    shaders/pbr.tese \
+    shaders/pbrdisplace.vert \
     shaders/cubemap.vert \
     shaders/equirectangular.frag \
     shaders/irradiance.frag \
@@ -181,6 +201,9 @@ DISTFILES += \
     shaders/circle.frag \
     shaders/transform.frag \
     shaders/tile.frag \
+    shaders/tilescatter.vert \
+    shaders/tilescatter.frag \
+    shaders/tilemask.frag \
     shaders/warp.frag \
     shaders/blur.frag \
     shaders/inverse.frag \
@@ -189,7 +212,6 @@ DISTFILES += \
     shaders/coloring.frag \
     shaders/mapping.frag \
     shaders/bombing.frag \
-    shaders/random.frag \
     shaders/mirror.frag \
     shaders/brightnesscontrast.frag \
     shaders/threshold.frag \
@@ -26,6 +26,7 @@ Rectangle {
     id: tab
     property bool selected: true
     property string fileName: "New"
+    property real progress: 1.0
     property Item baseParent
     signal activated()
     signal closed()
@@ -79,6 +80,13 @@ Rectangle {
         color: "#A2A2A2"
         verticalAlignment: Text.AlignVCenter
     }
+    Rectangle {
+        anchors.bottom: parent.bottom
+        width: parent.width*progress
+        height: 2
+        color: "#A2A2A2"
+        visible: progress < 1.0
+    }
     Image {
         y: 8
         anchors.right: parent.right
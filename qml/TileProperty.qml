@@ -40,6 +40,7 @@ Item {
     property alias startSeed: seedParam.propertyValue
     property alias startKeepProportion: keepProportionParam.checked
     property alias startUseAlpha: useAlphaParam.checked
+    property alias startScatter: scatterParam.checked
     signal offsetXChanged(real offset)
     signal offsetYChanged(real offset)
     signal columnsChanged(int columns)
@@ -55,12 +56,13 @@ Item {
     signal seedChanged(int seed)
     signal keepProportionChanged(bool keep)
     signal useAlphaChanged(bool use)
+    signal scatterChanged(bool scatter)
     signal propertyChangingFinished(string name, var newValue, var oldValue)
     ParamSlider {
         id: columnsParam
         propertyName: "Columns"
         minimum: 1
-        maximum: 20
+        maximum: scatterParam.checked ? 256 : 20
         step: 1
         onPropertyValueChanged: {
             columnsChanged(columnsParam.propertyValue)
@@ -74,7 +76,7 @@ Item {
         y: 33
         propertyName: "Rows"
         minimum: 1
-        maximum: 20
+        maximum: scatterParam.checked ? 256 : 20
         step: 1
         onPropertyValueChanged: {
             rowsChanged(rowsParam.propertyValue)
@@ -190,7 +192,7 @@ Item {
         id: inputsCountParam
         y: 363
         minimum: 1
-        maximum: 6
+        maximum: 32
         step: 1
         propertyName: "Inputs count"
         onPropertyValueChanged: {
@@ -308,4 +310,51 @@ Item {
             renderType: Text.NativeRendering
         }
     }
+    CheckBox {
+        id: scatterParam
+        y: 494
+        leftPadding: 30
+        height: 25
+        width: 140
+        text: qsTr("Scatter")
+        checked: false
+        onCheckedChanged: {
+            scatterChanged(scatterParam.checked)
+        }
+        onToggled: {
+            propertyChangingFinished("startScatter", checked, !checked)
+            focus = false
+        }
+
+        indicator: Item {
+            implicitWidth: 30
+            implicitHeight: 30
+            x: scatterParam.contentItem.width + 5
+            anchors.verticalCenter: parent.verticalCenter
+            Rectangle {
+                width: 14
+                height: 14
+                anchors.centerIn: parent
+                color: "transparent"
+                border.color: "#A2A2A2"
+                Rectangle {
+                    width: 6
+                    height: 6
+                    anchors.centerIn: parent
+                    visible: scatterParam.checked
+                    color: "#A2A2A2"
+                }
+            }
+        }
+
+        contentItem: Text {
+            topPadding: 0
+            text: scatterParam.text
+            color: "#A2A2A2"
+            horizontalAlignment: Text.AlignLeft
+            verticalAlignment: Text.AlignVCenter
+            elide: Text.ElideRight
+            renderType: Text.NativeRendering
+        }
+    }
 }
@@ -20,18 +20,10 @@
  */
 
 #version 440 core
-struct stopGradient {
-    vec4 color;
-    float pos;
-};
-
-layout (std430, binding = 0) buffer stops {
-    vec4 gradients[];
-};
 
 uniform sampler2D sourceTexture;
 uniform sampler2D maskTexture;
-uniform int stopCount;
+uniform sampler1D rampTexture;
 uniform bool useMask = false;
 
 in vec2 texCoords;
@@ -41,18 +33,9 @@ out vec4 FragColor;
 void main()
 {
     vec4 texColor = texture(sourceTexture, texCoords);
-    float x = (texColor.r + texColor.g + texColor.b)/3.0f;
-    vec3 color = stopCount > 0 ? gradients[0].rgb : vec3(1.0f);
-    for(int i = 1; i < stopCount; ++i) {
-        if((x > gradients[i - 1].w) && (x <= gradients[i].w)) {
-            float f = (x - gradients[i - 1].w)/(gradients[i].w - gradients[i - 1].w);
-            color = mix(gradients[i - 1].rgb, gradients[i].rgb, f);
-            break;
-        }
-    }
-    if(x > gradients[stopCount - 1].w) {
-        color = gradients[stopCount - 1].rgb;
-    }
+    float x = clamp((texColor.r + texColor.g + texColor.b)/3.0f, 0.0f, 1.0f);
+    float rampSize = textureSize(rampTexture, 0);
+    vec3 color = texture(rampTexture, x*(rampSize - 1.0f)/rampSize + 0.5f/rampSize).rgb;
     vec4 result = vec4(color, texColor.a);
     if(useMask) {
         vec4 maskColor = texture(maskTexture, texCoords);
@@ -0,0 +1,47 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+uint pcgHash(uint v) {
+    uint state = v*747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state)*277803737u;
+    return (word >> 22u) ^ word;
+}
+
+uint hashCell(ivec2 cell, int seed) {
+    return pcgHash(uint(cell.x) + pcgHash(uint(cell.y) + pcgHash(uint(seed))));
+}
+
+float hashToFloat(uint h) {
+    return float(h >> 8u)*(1.0/16777216.0);
+}
+
+vec2 hash22(ivec2 cell, int seed) {
+    uint h = hashCell(cell, seed);
+    return vec2(hashToFloat(h), hashToFloat(pcgHash(h)));
+}
+
+vec4 hash42(ivec2 cell, int seed) {
+    uint h1 = hashCell(cell, seed);
+    uint h2 = pcgHash(h1);
+    uint h3 = pcgHash(h2);
+    uint h4 = pcgHash(h3);
+    return vec4(hashToFloat(h1), hashToFloat(h2), hashToFloat(h3), hashToFloat(h4));
+}
@@ -28,24 +28,14 @@ uniform bool useMask = false;
 
 in vec2 texCoords;
 
+#include "uvchain.glsl"
+
 out vec4 FragColor;
 
 void main()
 {
-    vec2 coords = texCoords;
-    if(dir == 0) { //left to right
-        coords.x = coords.x < 0.5 ? coords.x : 1.0 - coords.x;
-    }
-    else if(dir == 1) { //right to left
-        coords.x = coords.x > 0.5 ? coords.x : 1.0 - coords.x;
-    }
-    else if(dir == 2) { //top to bottom
-        coords.y = coords.y > 0.5 ? coords.y : 1.0 - coords.y;
-    }
-    else if(dir == 3) { //bottom to top
-        coords.y = coords.y < 0.5 ? coords.y : 1.0 - coords.y;
-    }
-    vec4 result = texture(sourceTexture, coords);
+    vec2 coords = mirrorCoords(texCoords, dir);
+    vec4 result = texture(sourceTexture, upstreamCoords(coords));
     if(useMask) {
         vec4 maskColor = texture(maskTexture, texCoords);
         float mask = 0.33333*(maskColor.r + maskColor.g + maskColor.b);
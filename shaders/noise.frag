@@ -23,28 +23,28 @@
 
 subroutine float noiseType(vec2 st, vec2 size);
 subroutine uniform noiseType noise;
-uniform sampler2D maskTexture;
 uniform vec2 res;
 uniform float scale = 5.0;
-uniform int octaves = 8;
+uniform int layer = 0;
+uniform int octaves = 0;
 uniform float persistence = 0.5;
 uniform float amplitude = 1.0;
+uniform bool combined = false;
+uniform bool useMask = false;
+uniform sampler2D maskTexture;
 uniform float scaleX = 1.0;
 uniform float scaleY = 1.0;
 uniform int seed = 1;
-uniform bool useMask = false;
 out vec4 FragColor;
 
+#include "hash.glsl"
+
 float random (in vec2 st) {
-    return - 1.0 + 2.0*fract(sin(dot(st.xy,
-                         vec2(12.9898,78.233)))
-                 * 1367.454541*seed);
+    return -1.0 + 2.0*hashToFloat(hashCell(ivec2(st), seed));
 }
 
 vec2 random2(vec2 st){
-    st = vec2( dot(st,vec2(127.1,311.7)),
-              dot(st,vec2(269.5,183.3)) );
-    return (-1.0 + 2.0*fract(sin(st)*1367.454541*seed));
+    return -1.0 + 2.0*hash22(ivec2(st), seed);
 }
 vec3 mod289(vec3 x) { return x - floor(x * (1.0 / 289.0)) * 289.0; }
 vec2 mod289(vec2 x) { return x - floor(x * (1.0 / 289.0)) * 289.0; }
@@ -154,27 +154,28 @@ float noiseSimplex(vec2 v) {
 }
 
 void main() {
-   float frequency = floor(scale);
+   float frequency = floor(scale)*float(1 << layer);
    float lacunarity = 2.0;
    float ampl = amplitude;
    vec2 st = gl_FragCoord.xy/res;
    st.x *= res.x/res.y;
    vec2 s = vec2(scaleX, scaleY);
-   vec3 color = vec3(0.0);
+   float value = 0.0;
 
    for(int i = 0; i <= octaves; ++i) {
-      color += ampl*noise(st*frequency*s, frequency*s);
+      value += ampl*noise(st*frequency*s, frequency*s);
       frequency *= lacunarity;
       ampl *= persistence;
    }
 
-   color =  0.5 + color*0.5;
-
-   vec4 result = vec4(color, 1.0);
-   if(useMask) {
-       vec4 maskColor = texture(maskTexture, st);
-       float mask = 0.33333*(maskColor.r + maskColor.g + maskColor.b);
-       result *= mask;
+   vec4 result = vec4(0.5 + value*0.5);
+   if(combined) {
+       result.a = 1.0;
+       if(useMask) {
+           vec4 maskColor = texture(maskTexture, st);
+           float mask = 0.33333*(maskColor.r + maskColor.g + maskColor.b);
+           result *= mask;
+       }
    }
 
    FragColor = result;
@@ -0,0 +1,55 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#version 440 core
+
+uniform sampler2DArray layersTexture;
+uniform sampler2D maskTexture;
+uniform vec2 res;
+uniform int octaves = 8;
+uniform float persistence = 0.5;
+uniform float amplitude = 1.0;
+uniform bool useMask = false;
+out vec4 FragColor;
+
+void main() {
+   ivec2 texel = ivec2(gl_FragCoord.xy);
+   float ampl = amplitude;
+   float value = 0.0;
+
+   for(int i = 0; i <= octaves; ++i) {
+      value += ampl*(texelFetch(layersTexture, ivec3(texel, i), 0).r*2.0 - 1.0);
+      ampl *= persistence;
+   }
+
+   vec3 color = vec3(0.5 + value*0.5);
+
+   vec4 result = vec4(color, 1.0);
+   if(useMask) {
+       vec2 st = gl_FragCoord.xy/res;
+       st.x *= res.x/res.y;
+       vec4 maskColor = texture(maskTexture, st);
+       float mask = 0.33333*(maskColor.r + maskColor.g + maskColor.b);
+       result *= mask;
+   }
+
+   FragColor = result;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#version 440 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in vec3 aTangent;
+layout (location = 4) in vec3 aBitangent;
+
+out vec2 TexCoords;
+out vec3 WorldPos;
+out vec3 Normal;
+out vec3 Pos;
+
+uniform mat4 projection;
+uniform mat4 view;
+uniform mat4 model;
+uniform sampler2D heightMap;
+uniform float heightScale = 0.1;
+uniform int tilesSize = 1;
+
+float height(vec2 uv) {
+    return textureLod(heightMap, uv*tilesSize, 0.0).r;
+}
+
+void main()
+{
+    vec3 normal = normalize(aNormal);
+    vec2 e = 1.0/(vec2(textureSize(heightMap, 0))*tilesSize);
+    float h = height(aTexCoords);
+    float dhdu = (height(aTexCoords + vec2(e.x, 0.0)) - height(aTexCoords - vec2(e.x, 0.0)))/(2.0*e.x);
+    float dhdv = (height(aTexCoords + vec2(0.0, e.y)) - height(aTexCoords - vec2(0.0, e.y)))/(2.0*e.y);
+    vec3 n = cross(aTangent + normal*heightScale*dhdu, aBitangent + normal*heightScale*dhdv);
+    if(length(n) > 0.000001) {
+        n = normalize(n);
+        if(dot(n, normal) < 0.0) n = -n;
+    }
+    else {
+        n = normal;
+    }
+    vec3 pos = aPos + normal*h*heightScale;
+
+    TexCoords = aTexCoords;
+    WorldPos = vec3(model * vec4(pos, 1.0));
+    Normal = mat3(model) * n;
+    Pos = pos;
+
+    gl_Position =  projection * view * vec4(WorldPos, 1.0);
+}
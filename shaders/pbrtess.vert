@@ -0,0 +1,42 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#version 440 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in vec3 aTangent;
+layout (location = 4) in vec3 aBitangent;
+
+out vec3 vPos;
+out vec3 vNormal;
+out vec2 vTexCoords;
+out vec3 vTangent;
+out vec3 vBitangent;
+
+void main()
+{
+    vPos = aPos;
+    vNormal = aNormal;
+    vTexCoords = aTexCoords;
+    vTangent = aTangent;
+    vBitangent = aBitangent;
+}
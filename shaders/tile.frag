@@ -35,20 +35,18 @@ uniform float maskStrength = 0.0;
 uniform bool keepProportion = false;
 uniform bool useAlpha = true;
 uniform int inputCount = 1;
+uniform int tileLayers[32];
+uniform int seed = 1;
 uniform bool useMask = false;
-uniform sampler2D textureTile;
-uniform sampler2D tile1;
-uniform sampler2D tile2;
-uniform sampler2D tile3;
-uniform sampler2D tile4;
-uniform sampler2D tile5;
-uniform sampler2D randomTexture;
+uniform sampler2DArray tiles;
 uniform sampler2D maskTexture;
 
 in vec2 texCoords;
 
 out vec4 FragColor;
 
+#include "hash.glsl"
+
 mat2 rotate2d(float _angle){
     return mat2(cos(_angle),-sin(_angle),
                 sin(_angle),cos(_angle));
@@ -72,8 +70,7 @@ void main()
     }
     vec2 cell = floor(scaledUV);
     vec2 offset = fract(scaledUV);
-    vec2 randomUV = cell*vec2(0.037, 0.119);
-    vec4 random = texture(randomTexture, randomUV);
+    vec4 random;
     float priority = -1.0;
     vec4 image;
     vec4 color = vec4(0.0);
@@ -82,9 +79,7 @@ void main()
             vec2 cell_t = cell + vec2(i, j);
             cell_t = mod(cell_t, vec2(columns, rows));
             vec2 offset_t = offset - vec2(i, j);
-            randomUV = cell_t*vec2(0.037, 0.119);
-            random = texture(randomTexture, randomUV);
-            randomUV += vec2(0.03, 0.17);
+            random = hash42(ivec2(cell_t), seed);
 
             vec2 coords = (offset_t - vec2(mod(cell_t.y, 2.0)*offsetX, mod(cell_t.x, 2.0)*offsetY) +
                            random.xy*randPosition);
@@ -99,24 +94,8 @@ void main()
             coords += 0.5;           
             if((coords.x < 0.0 || coords.y < 0.0 || coords.x > 1.0 || coords.y > 1.0)) continue;
             int textureNumber = int(floor((random.z + random.w)*0.5*(inputCount - 0.1)));
-            if(textureNumber == 0) {
-                image = texture(textureTile, coords);
-            }
-            else if(textureNumber == 1) {
-                image = texture(tile1, coords);
-            }
-            else if(textureNumber == 2) {
-                image = texture(tile2, coords);
-            }
-            else if(textureNumber == 3) {
-                image = texture(tile3, coords);
-            }
-            else if(textureNumber == 4) {
-                image = texture(tile4, coords);
-            }
-            else if(textureNumber == 5) {
-                image = texture(tile5, coords);
-            }
+            int layer = tileLayers[textureNumber];
+            image = layer < 0 ? vec4(0.0) : texture(tiles, vec3(coords, layer));
             float maskS = 1.0 - (random.x + random.y)*0.5*maskStrength;
 
             if(image.a > 0) {
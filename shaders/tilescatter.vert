@@ -0,0 +1,41 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#version 440 core
+
+layout (location = 0) in vec2 corner;
+layout (location = 1) in vec2 origin;
+layout (location = 2) in vec2 axisU;
+layout (location = 3) in vec2 axisV;
+layout (location = 4) in vec2 shadeInput;
+
+out vec2 texCoords;
+out float shade;
+flat out int inputNumber;
+
+void main()
+{
+    vec2 pos = origin + corner.x*axisU + corner.y*axisV;
+    texCoords = corner;
+    shade = shadeInput.x;
+    inputNumber = int(shadeInput.y);
+    gl_Position = vec4(2.0*pos - 1.0, 0.0, 1.0);
+}
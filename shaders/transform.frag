@@ -32,6 +32,8 @@ uniform bool useMask = false;
 
 in vec2 texCoords;
 
+#include "uvchain.glsl"
+
 out vec4 FragColor;
 
 mat2 rotate2d(float _angle){
@@ -48,7 +50,7 @@ void main()
     coords *= vec2(1.0)/scale;
     coords += 0.5;
     coords = clampTrans ? clamp(coords, vec2(0.0), vec2(1.0)) : coords;
-    vec4 result = texture(transTexture, coords);
+    vec4 result = texture(transTexture, upstreamCoords(coords));
     if(useMask) {
         vec4 maskColor = texture(maskTexture, texCoords);
         float mask = 0.33333*(maskColor.r + maskColor.g + maskColor.b);
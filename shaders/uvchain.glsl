@@ -0,0 +1,55 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+uniform int stageCount = 0;
+uniform mat3 stageMatrix[8];
+uniform int stageMode[8];
+uniform int stageDir[8];
+
+vec2 mirrorCoords(vec2 coords, int direction) {
+    if(direction == 0) { //left to right
+        coords.x = coords.x < 0.5 ? coords.x : 1.0 - coords.x;
+    }
+    else if(direction == 1) { //right to left
+        coords.x = coords.x > 0.5 ? coords.x : 1.0 - coords.x;
+    }
+    else if(direction == 2) { //top to bottom
+        coords.y = coords.y > 0.5 ? coords.y : 1.0 - coords.y;
+    }
+    else if(direction == 3) { //bottom to top
+        coords.y = coords.y < 0.5 ? coords.y : 1.0 - coords.y;
+    }
+    return coords;
+}
+
+vec2 upstreamCoords(vec2 coords) {
+    for(int i = 0; i < stageCount; ++i) {
+        coords = fract(coords);
+        if(stageMode[i] == 2) {
+            coords = mirrorCoords(coords, stageDir[i]);
+        }
+        else {
+            coords = (stageMatrix[i]*vec3(coords, 1.0)).xy;
+            coords = stageMode[i] == 1 ? clamp(coords, vec2(0.0), vec2(1.0)) : coords;
+        }
+    }
+    return coords;
+}
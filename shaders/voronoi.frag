@@ -23,6 +23,7 @@
 subroutine float voronoiType(vec2 st);
 subroutine uniform voronoiType voronoiFunction;
 uniform sampler2D maskTexture;
+uniform sampler2D featurePoints;
 uniform vec2 res;
 uniform int scale = 5;
 uniform int scaleX = 1;
@@ -37,8 +38,9 @@ uniform bool useMask = false;
 out vec4 FragColor;
 
 vec2 random2( vec2 p ) {
-    p = mod(p, scale*vec2(scaleX, scaleY));
-    return fract(sin(vec2(dot(p,vec2(127.1,311.7)),dot(p,vec2(269.5,183.3))))*1367.454541*seed);
+    ivec2 size = textureSize(featurePoints, 0);
+    ivec2 cell = (ivec2(floor(p + 0.5)) + 4*size) % size;
+    return texelFetch(featurePoints, cell, 0).xy;
 }
 
 vec2 f2Voronoi(vec2 st) {
@@ -20,10 +20,10 @@
  */
 
 #include "albedo.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include <iostream>
 
-AlbedoObject::AlbedoObject(QQuickItem *parent, QVector2D resolution): QQuickFramebufferObject (parent),
+AlbedoObject::AlbedoObject(QQuickItem *parent, QVector2D resolution): ThumbnailObject(parent),
     m_resolution(resolution)
 {
 }
@@ -69,10 +69,7 @@ void AlbedoObject::setResolution(QVector2D res) {
 
 AlbedoRenderer::AlbedoRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
-    renderAlbedo = new QOpenGLShaderProgram();
-    renderAlbedo->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    renderAlbedo->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/albedo.frag");
-    renderAlbedo->link();
+    renderAlbedo = createShaderProgram(PROGRAM_ALBEDO);
 
     float vertQuadTex[] = {-1.0f, -1.0f, 0.0f, 0.0f,
                     -1.0f, 1.0f, 0.0f, 1.0f,
@@ -114,14 +111,8 @@ AlbedoRenderer::~AlbedoRenderer() {
     delete renderAlbedo;
 }
 
-QOpenGLFramebufferObject *AlbedoRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void AlbedoRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     AlbedoObject *albedoItem = static_cast<AlbedoObject*>(item);
     renderAlbedo->bind();
     renderAlbedo->setUniformValue(renderAlbedo->uniformLocation("useAlbedoTex"), albedoItem->useAlbedoTex);
@@ -146,7 +137,7 @@ void AlbedoRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void AlbedoRenderer::render() {
+void AlbedoRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_ONE, GL_ZERO, GL_ZERO, GL_ONE);
@@ -21,12 +21,12 @@
 
 #ifndef ALBEDO_H
 #define ALBEDO_H
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class AlbedoObject: public QQuickFramebufferObject
+class AlbedoObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -54,13 +54,12 @@ private:
     QVector2D m_resolution;
 };
 
-class AlbedoRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class AlbedoRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     AlbedoRenderer(QVector2D resolution);
     ~AlbedoRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void saveTexture(QString fileName);
     void createColor();
@@ -39,17 +39,18 @@ AlbedoNode::AlbedoNode(QQuickItem *parent, QVector2D resolution): Node(parent, r
     createSockets(1, 0);
     setTitle("Albedo");
     m_socketsInput[0]->setTip("Albedo");
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/AlbedoProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    connect(propertiesPanel, SIGNAL(albedoChanged(QVector3D)), this, SLOT(updateAlbedo(QVector3D)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/AlbedoProperty.qml"));
 }
 
 AlbedoNode::~AlbedoNode() {
     delete preview;
 }
 
+void AlbedoNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startColor", m_albedo);
+    connect(propertiesPanel, SIGNAL(albedoChanged(QVector3D)), this, SLOT(updateAlbedo(QVector3D)));
+}
+
 void AlbedoNode::operation() {
     if(m_socketsInput[0]->countEdge() > 0) {
         preview->useAlbedoTex = true;
@@ -88,14 +89,13 @@ void AlbedoNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &ha
         QVector3D color = QVector3D(albedo[0].toVariant().toFloat(), albedo[1].toVariant().toFloat(),
                              albedo[2].toVariant().toFloat());
         updateAlbedo(color);
-        propertiesPanel->setProperty("startColor", color);
     }
 }
 
 void AlbedoNode::updateAlbedo(QVector3D color) {
     m_albedo = color;
     if(m_socketsInput[0]->countEdge() == 0) {
-        operation();
+        requestOperation();
     }
     dataChanged();
 }
@@ -41,6 +41,8 @@ public slots:
     void updateAlbedo(QVector3D color);
     void updateScale(float scale);
     void saveAlbedo(QString dir);
+protected:
+    void setupPropertyPanel();
 private:
     AlbedoObject *preview;
     QVector3D m_albedo = QVector3D(1.0f, 1.0f, 1.0f);
@@ -20,6 +20,7 @@
  */
 
 #include "backgroundrenderer.h"
+#include "shaderwarmup.h"
 #include <QOpenGLFramebufferObjectFormat>
 #include "backgroundobject.h"
 #include <iostream>
@@ -27,10 +28,7 @@
 BackgroundRenderer::BackgroundRenderer()
 {
     initializeOpenGLFunctions();
-    backgroundGrid = new QOpenGLShaderProgram();
-    backgroundGrid->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/grid.vert");
-    backgroundGrid->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/grid.frag");
-    backgroundGrid->link();
+    backgroundGrid = createShaderProgram(PROGRAM_GRID);
 
     float vert[] = {-1.0f, -1.0f,
                     -1.0f, 1.0f,
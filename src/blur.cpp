@@ -20,11 +20,11 @@
  */
 
 #include "blur.h"
+#include "shaderwarmup.h"
 #include <iostream>
-#include <QOpenGLFramebufferObjectFormat>
 
 BlurObject::BlurObject(QQuickItem *parent, QVector2D resolution, float intensity):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_intensity(intensity)
+    ThumbnailObject(parent), m_resolution(resolution), m_intensity(intensity)
 {
 }
 
@@ -89,18 +89,9 @@ void BlurObject::setResolution(QVector2D res) {
 
 BlurRenderer::BlurRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    blurShader = new QOpenGLShaderProgram();
-    blurShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    blurShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/blur.frag");
-    blurShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    blurShader = createShaderProgram(PROGRAM_BLUR);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     blurShader->bind();
     blurShader->setUniformValue(blurShader->uniformLocation("sourceTexture"), 0);
     blurShader->setUniformValue(blurShader->uniformLocation("maskTexture"), 1);
@@ -151,14 +142,8 @@ BlurRenderer::~BlurRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *BlurRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void BlurRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     BlurObject *blurItem = static_cast<BlurObject*>(item);
     if(blurItem->resUpdated) {
         blurItem->resUpdated = false;
@@ -184,7 +169,7 @@ void BlurRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void BlurRenderer::render() {
+void BlurRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -22,12 +22,12 @@
 #ifndef BLUR_H
 #define BLUR_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class BlurObject: public QQuickFramebufferObject
+class BlurObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -60,13 +60,12 @@ private:
     float m_intensity = 0.5f;
 };
 
-class BlurRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class BlurRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     BlurRenderer(QVector2D res);
     ~BlurRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void createBlur();
     void updateTexResolution();
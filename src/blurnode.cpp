@@ -39,12 +39,7 @@ BlurNode::BlurNode(QQuickItem *parent, QVector2D resolution, float intensity): N
     connect(this, &Node::changeResolution, preview, &BlurObject::setResolution);
     connect(this, &BlurNode::intensityChanged, preview, &BlurObject::setIntensity);
     connect(preview, &BlurObject::updatePreview, this, &BlurNode::updatePreview);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/BlurProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    propertiesPanel->setProperty("startIntensity", m_intensity);
-    connect(propertiesPanel, SIGNAL(intensityChanged(qreal)), this, SLOT(updateIntensity(qreal)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/BlurProperty.qml"));
     createSockets(2, 1);
     setTitle("Blur");
     m_socketsInput[0]->setTip("Texture");
@@ -55,6 +50,11 @@ BlurNode::~BlurNode() {
     delete preview;
 }
 
+void BlurNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startIntensity", m_intensity);
+    connect(propertiesPanel, SIGNAL(intensityChanged(qreal)), this, SLOT(updateIntensity(qreal)));
+}
+
 void BlurNode::operation() {
     preview->selectedItem = selected();
     preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
@@ -70,6 +70,10 @@ void BlurNode::saveTexture(QString fileName) {
     preview->saveTexture(fileName);
 }
 
+bool BlurNode::costlyOperation() const {
+    return true;
+}
+
 void BlurNode::serialize(QJsonObject &json) const {
     Node::serialize(json);
     json["type"] = 19;
@@ -79,8 +83,7 @@ void BlurNode::serialize(QJsonObject &json) const {
 void BlurNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
     Node::deserialize(json, hash);
     if(json.contains("intensity")) {
-        m_intensity = json["intensity"].toVariant().toFloat();
-        propertiesPanel->setProperty("startIntensity", m_intensity);
+        setIntensity(json["intensity"].toVariant().toFloat());
     }
 }
 
@@ -110,6 +113,6 @@ void BlurNode::setOutput() {
 
 void BlurNode::updateIntensity(qreal intensity) {
     setIntensity(intensity);
-    operation();
+    requestOperation();
     dataChanged();
 }
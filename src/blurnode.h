@@ -34,6 +34,7 @@ public:
     void operation();
     unsigned int &getPreviewTexture();
     void saveTexture(QString fileName);
+    bool costlyOperation() const;
     void serialize(QJsonObject &json) const;
     void deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash);
     float intensity();
@@ -45,6 +46,8 @@ public slots:
     void previewGenerated();
     void setOutput();
     void updateIntensity(qreal intensity);
+protected:
+    void setupPropertyPanel();
 private:
     BlurObject *preview;
     float m_intensity = 0.5f;
@@ -20,12 +20,12 @@
  */
 
 #include "brightnesscontrast.h"
+#include "shaderwarmup.h"
 #include <iostream>
-#include <QOpenGLFramebufferObjectFormat>
 
 BrightnessContrastObject::BrightnessContrastObject(QQuickItem *parent, QVector2D resolution,
                                                    float brightness, float contrast):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_brightness(brightness),
+    ThumbnailObject(parent), m_resolution(resolution), m_brightness(brightness),
     m_contrast(contrast)
 {
 }
@@ -91,18 +91,9 @@ void BrightnessContrastObject::setResolution(QVector2D res) {
 
 BrightnessContrastRenderer::BrightnessContrastRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    brightnessContrastShader = new QOpenGLShaderProgram();
-    brightnessContrastShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    brightnessContrastShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/brightnesscontrast.frag");
-    brightnessContrastShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    brightnessContrastShader = createShaderProgram(PROGRAM_BRIGHTNESS_CONTRAST);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     brightnessContrastShader->bind();
     brightnessContrastShader->setUniformValue(brightnessContrastShader->uniformLocation("sourceTexture"), 0);
     brightnessContrastShader->release();
@@ -146,14 +137,8 @@ BrightnessContrastRenderer::~BrightnessContrastRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *BrightnessContrastRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void BrightnessContrastRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     BrightnessContrastObject *brightnessContrastItem = static_cast<BrightnessContrastObject*>(item);
     if(brightnessContrastItem->resUpdated) {
         brightnessContrastItem->resUpdated = false;
@@ -179,7 +164,7 @@ void BrightnessContrastRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void BrightnessContrastRenderer::render() {
+void BrightnessContrastRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
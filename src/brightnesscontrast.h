@@ -22,12 +22,12 @@
 #ifndef BRIGHTNESSCONTRAST_H
 #define BRIGHTNESSCONTRAST_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class BrightnessContrastObject: public QQuickFramebufferObject
+class BrightnessContrastObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -60,13 +60,12 @@ private:
     float m_contrast = 0.0f;
 };
 
-class BrightnessContrastRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class BrightnessContrastRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     BrightnessContrastRenderer(QVector2D res);
     ~BrightnessContrastRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void create();
     void updateTexResolution();
@@ -40,14 +40,7 @@ BrightnessContrastNode::BrightnessContrastNode(QQuickItem *parent, QVector2D res
     connect(this, &Node::changeResolution, preview, &BrightnessContrastObject::setResolution);
     connect(this, &BrightnessContrastNode::brightnessChanged, preview, &BrightnessContrastObject::setBrightness);
     connect(this, &BrightnessContrastNode::contrastChanged, preview, &BrightnessContrastObject::setContrast);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/BrightnessContrastProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    propertiesPanel->setProperty("startBrightness", m_brightness);
-    propertiesPanel->setProperty("startContrast", m_contrast);
-    connect(propertiesPanel, SIGNAL(brightnessChanged(qreal)), this, SLOT(updateBrightness(qreal)));
-    connect(propertiesPanel, SIGNAL(contrastChanged(qreal)), this, SLOT(updateContrast(qreal)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/BrightnessContrastProperty.qml"));
     createSockets(1, 1);
     setTitle("Brightness-Contrast");
     m_socketsInput[0]->setTip("Texture");
@@ -57,6 +50,13 @@ BrightnessContrastNode::~BrightnessContrastNode() {
     delete preview;
 }
 
+void BrightnessContrastNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startBrightness", m_brightness);
+    propertiesPanel->setProperty("startContrast", m_contrast);
+    connect(propertiesPanel, SIGNAL(brightnessChanged(qreal)), this, SLOT(updateBrightness(qreal)));
+    connect(propertiesPanel, SIGNAL(contrastChanged(qreal)), this, SLOT(updateContrast(qreal)));
+}
+
 void BrightnessContrastNode::operation() {
     preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
     if(m_socketsInput[0]->countEdge() == 0) m_socketOutput[0]->setValue(0);
@@ -81,11 +81,9 @@ void BrightnessContrastNode::deserialize(const QJsonObject &json, QHash<QUuid, S
     Node::deserialize(json, hash);
     if(json.contains("brightness")) {
         updateBrightness(json["brightness"].toVariant().toReal());
-        propertiesPanel->setProperty("startBrightness", m_brightness);
     }
     if(json.contains("contrast")) {
         updateContrast(json["contrast"].toVariant().toReal());
-        propertiesPanel->setProperty("startContrast", m_contrast);
     }
 }
 
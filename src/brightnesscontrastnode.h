@@ -49,6 +49,8 @@ public slots:
     void setOutput();
     void updateBrightness(qreal value);
     void updateContrast(qreal value);
+protected:
+    void setupPropertyPanel();
 private:
     BrightnessContrastObject *preview;
     float m_brightness = 0.0f;
@@ -20,11 +20,11 @@
  */
 
 #include "circle.h"
-#include "QOpenGLFramebufferObjectFormat"
+#include "shaderwarmup.h"
 #include <iostream>
 
 CircleObject::CircleObject(QQuickItem *parent, QVector2D resolution, int interpolation, float radius,
-                           float smooth, bool useAlpha): QQuickFramebufferObject (parent),
+                           float smooth, bool useAlpha): ThumbnailObject(parent),
     m_resolution(resolution), m_interpolation(interpolation), m_radius(radius), m_smooth(smooth),
     m_useAlpha(useAlpha)
 {
@@ -112,21 +112,12 @@ void CircleObject::setResolution(QVector2D res) {
 
 CircleRenderer::CircleRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
-    generateCircle = new QOpenGLShaderProgram();
-    generateCircle->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/noise.vert");
-    generateCircle->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/circle.frag");
-    generateCircle->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    renderTexture = new QOpenGLShaderProgram();
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
+    generateCircle = createShaderProgram(PROGRAM_CIRCLE);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    renderTexture = createShaderProgram(PROGRAM_TEXTURE);
     generateCircle->bind();
     generateCircle->setUniformValue(generateCircle->uniformLocation("maskTexture"), 0);
     generateCircle->release();
-    renderTexture->link();
     renderTexture->bind();
     renderTexture->setUniformValue(renderTexture->uniformLocation("texture"), 0);
     renderTexture->release();
@@ -183,14 +174,8 @@ CircleRenderer::~CircleRenderer() {
     delete renderTexture;
 }
 
-QOpenGLFramebufferObject *CircleRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void CircleRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     CircleObject *circleItem = static_cast<CircleObject*>(item);
     if(circleItem->resUpdated) {
         circleItem->resUpdated = false;
@@ -221,7 +206,7 @@ void CircleRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void CircleRenderer::render() {
+void CircleRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -22,12 +22,12 @@
 #ifndef CIRCLE_H
 #define CIRCLE_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class CircleObject: public QQuickFramebufferObject
+class CircleObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -66,13 +66,12 @@ private:
     bool m_useAlpha = true;
 };
 
-class CircleRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class CircleRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     CircleRenderer(QVector2D resolution);
     ~CircleRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void createCircle();
     void updateTexResolution();
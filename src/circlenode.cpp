@@ -45,9 +45,14 @@ CircleNode::CircleNode(QQuickItem *parent, QVector2D resolution, int interpolati
     createSockets(1, 1);
     m_socketsInput[0]->setTip("Mask");
     setTitle("Circle");
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/CircleProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/CircleProperty.qml"));
+}
+
+CircleNode::~CircleNode() {
+    delete preview;
+}
+
+void CircleNode::setupPropertyPanel() {
     propertiesPanel->setProperty("startInterpolation", m_interpolation);
     propertiesPanel->setProperty("startRadius", m_radius);
     propertiesPanel->setProperty("startSmooth", m_smooth);
@@ -56,11 +61,6 @@ CircleNode::CircleNode(QQuickItem *parent, QVector2D resolution, int interpolati
     connect(propertiesPanel, SIGNAL(radiusChanged(qreal)), this, SLOT(updateRadius(qreal)));
     connect(propertiesPanel, SIGNAL(smoothValueChanged(qreal)), this, SLOT(updateSmooth(qreal)));
     connect(propertiesPanel, SIGNAL(useAlphaChanged(bool)), this, SLOT(updateUseAlpha(bool)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-}
-
-CircleNode::~CircleNode() {
-    delete preview;
 }
 
 void CircleNode::operation() {
@@ -88,22 +88,17 @@ void CircleNode::serialize(QJsonObject &json) const {
 void CircleNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
     Node::deserialize(json, hash);
     if(json.contains("interpolation")) {
-        m_interpolation = json["interpolation"].toVariant().toInt();
-        interpolationChanged(m_interpolation);
+        setInterpolation(json["interpolation"].toVariant().toInt());
     }
     if(json.contains("radius")) {
-        m_radius = json["radius"].toVariant().toFloat();
+        setRadius(json["radius"].toVariant().toFloat());
     }
     if(json.contains("smooth")) {
-        m_smooth = json["smooth"].toVariant().toFloat();
+        setSmooth(json["smooth"].toVariant().toFloat());
     }
     if(json.contains("useAlpha")) {
-        m_useAlpha = json["useAlpha"].toBool();
+        setUseAlpha(json["useAlpha"].toBool());
     }
-    propertiesPanel->setProperty("startInterpolation", m_interpolation);
-    propertiesPanel->setProperty("startRadius", m_radius);
-    propertiesPanel->setProperty("startSmooth", m_smooth);
-    propertiesPanel->setProperty("startUseAlpha", m_useAlpha);
 }
 
 int CircleNode::interpolation() {
@@ -42,6 +42,7 @@
 #include "albedonode.h"
 #include "metalnode.h"
 #include "roughnode.h"
+#include "heightnode.h"
 #include "normalnode.h"
 #include <iostream>
 
@@ -74,7 +75,7 @@ void Clipboard::copy(Scene *scene) {
     float minX = std::numeric_limits<float>::max();
     float minY = minX;
     for(auto item: selected) {
-        if(!(qobject_cast<AlbedoNode*>(item) || qobject_cast<MetalNode*>(item) || qobject_cast<RoughNode*>(item) || qobject_cast<NormalNode*>(item))) {
+        if(!(qobject_cast<AlbedoNode*>(item) || qobject_cast<MetalNode*>(item) || qobject_cast<RoughNode*>(item) || qobject_cast<NormalNode*>(item) || qobject_cast<HeightNode*>(item))) {
             if(qobject_cast<Node*>(item)) {
                 Node *node = qobject_cast<Node*>(item);
                 if(!node->attachedFrame() || !node->attachedFrame()->selected()) sel_nodes.append(node);
@@ -87,7 +88,7 @@ void Clipboard::copy(Scene *scene) {
                     if(sel_edges.contains(edge)) continue;
                     Node *startNode = qobject_cast<Node*>(edge->startSocket()->parentItem());
                     Node *endNode = qobject_cast<Node*>(edge->endSocket()->parentItem());
-                    if((startNode && startNode->selected()) && (!(qobject_cast<AlbedoNode*>(endNode) || qobject_cast<MetalNode*>(endNode) || qobject_cast<RoughNode*>(endNode) || qobject_cast<NormalNode*>(endNode)) && endNode->selected())) {
+                    if((startNode && startNode->selected()) && (!(qobject_cast<AlbedoNode*>(endNode) || qobject_cast<MetalNode*>(endNode) || qobject_cast<RoughNode*>(endNode) || qobject_cast<NormalNode*>(endNode) || qobject_cast<HeightNode*>(endNode)) && endNode->selected())) {
                         sel_edges.append(edge);
                     }
                 }
@@ -103,8 +104,8 @@ void Clipboard::copy(Scene *scene) {
         }
     }
 
-    center.setX(((maxX - minX)*0.5 + minX + scene->background()->viewPan().x())/scene->background()->viewScale());
-    center.setY(((maxY - minY)*0.5 + minY + scene->background()->viewPan().y())/scene->background()->viewScale());
+    center.setX(((maxX - minX)*0.5 + minX)/scene->background()->viewScale());
+    center.setY(((maxY - minY)*0.5 + minY)/scene->background()->viewScale());
 
     for(auto frame: sel_frames) {
         Frame *f = new Frame();
@@ -117,11 +118,12 @@ void Clipboard::copy(Scene *scene) {
         QList<QQuickItem*> copiedContent;
         for(auto item: frame->contentList()) {
             Node *baseNode = qobject_cast<Node*>(item);
-            if(baseNode && !(qobject_cast<AlbedoNode*>(item) || qobject_cast<MetalNode*>(item) || qobject_cast<RoughNode*>(item) || qobject_cast<NormalNode*>(item)) && baseNode->selected()) {
+            if(baseNode && !(qobject_cast<AlbedoNode*>(item) || qobject_cast<MetalNode*>(item) || qobject_cast<RoughNode*>(item) || qobject_cast<NormalNode*>(item) || qobject_cast<HeightNode*>(item)) && baseNode->selected()) {
                 Node *copiedContentNode = nodeCopy(baseNode, scene, nullptr);
                 copiedContentNode->setBaseX(baseNode->baseX());
                 copiedContentNode->setBaseY(baseNode->baseY());
                 copiedContent.append(copiedContentNode);
+                clipboard_outputs[copiedContentNode] = CopiedOutput{baseNode, scene->outputHash(baseNode)};
             }
         }
         if(copiedContent.size() > 0) f->addNodes(copiedContent);
@@ -131,11 +133,12 @@ void Clipboard::copy(Scene *scene) {
         copiedNode->setBaseX(node->baseX());
         copiedNode->setBaseY(node->baseY());
         clipboard_nodes.append(copiedNode);
+        clipboard_outputs[copiedNode] = CopiedOutput{node, scene->outputHash(node)};
     }
     for(auto edge: sel_edges) {
         Edge *e = new Edge();
-        e->setStartPosition((edge->startPosition() + scene->background()->viewPan())/scene->background()->viewScale());
-        e->setEndPosition((edge->endPosition() + scene->background()->viewPan())/scene->background()->viewScale());
+        e->setStartPosition(edge->startPosition()/scene->background()->viewScale());
+        e->setEndPosition(edge->endPosition()/scene->background()->viewScale());
         clipboard_edges.append(e);
     }
 }
@@ -147,13 +150,14 @@ void Clipboard::paste(float posX, float posY, Scene *scene) {
     float viewScale = scene->background()->viewScale();
     QVector2D viewPan = scene->background()->viewPan();
     QVector2D currentCenter = center*viewScale - viewPan;
+    QHash<Node*, CopiedOutput> pastedOutputs;
 
     scene->clearSelected();
+    scene->suspendEvaluation();
     for(auto f: clipboard_frames) {
         Frame *frame = new Frame(scene);
         float x = posX - (currentCenter.x() - (f->baseX()*viewScale - viewPan.x()));
         float y = posY - (currentCenter.y() - (f->baseY()*viewScale - viewPan.y()));
-        frame->setPan(viewPan);
         frame->setScaleView(viewScale);
         frame->setBaseX((viewPan.x() + x)/viewScale);
         frame->setBaseY((viewPan.y() + y)/viewScale);
@@ -169,6 +173,7 @@ void Clipboard::paste(float posX, float posY, Scene *scene) {
             if(qobject_cast<Node*>(item)) {
                 Node *baseNode = qobject_cast<Node*>(item);
                 Node *pastedNode = nodeCopy(baseNode, scene, scene);
+                pastedOutputs[pastedNode] = clipboard_outputs.value(baseNode);
                 float x = posX - (currentCenter.x() - (baseNode->baseX()*viewScale - viewPan.x()));
                 float y = posY - (currentCenter.y() - (baseNode->baseY()*viewScale - viewPan.y()));
                 pastedNode->setBaseX((viewPan.x() + x)/viewScale);
@@ -184,6 +189,7 @@ void Clipboard::paste(float posX, float posY, Scene *scene) {
     }
     for(auto n: clipboard_nodes) {
         Node *pastedNode = nodeCopy(n, scene, scene);
+        pastedOutputs[pastedNode] = clipboard_outputs.value(n);
         float x = posX - (currentCenter.x() - (n->baseX()*viewScale - viewPan.x()));
         float y = posY - (currentCenter.y() - (n->baseY()*viewScale - viewPan.y()));
         pastedNode->setBaseX((viewPan.x() + x)/viewScale);
@@ -193,14 +199,11 @@ void Clipboard::paste(float posX, float posY, Scene *scene) {
         scene->addSelected(pastedNode);
         pastedItem.append(pastedNode);
     }
+    QVector2D edgeOffset = QVector2D(posX, posY) + viewPan - center*viewScale;
     for(auto e: clipboard_edges) {
-        Edge *edge = new Edge(scene);
-        float startX = e->startPosition().x()*viewScale - viewPan.x();
-        float startY = e->startPosition().y()*viewScale - viewPan.y();
-        float endX = e->endPosition().x()*viewScale - viewPan.x();
-        float endY = e->endPosition().y()*viewScale - viewPan.y();
-        edge->setStartPosition(QVector2D(posX - (currentCenter.x() - startX), posY - (currentCenter.y() - startY)));
-        edge->setEndPosition(QVector2D(posX - (currentCenter.x() - endX), posY - (currentCenter.y() - endY)));
+        Edge *edge = new Edge(scene->canvas());
+        edge->setStartPosition(e->startPosition()*viewScale + edgeOffset);
+        edge->setEndPosition(e->endPosition()*viewScale + edgeOffset);
         Socket *startSock = edge->findSockets(scene, edge->startPosition().x(), edge->startPosition().y());
         if(startSock) {
             edge->setStartSocket(startSock);
@@ -212,10 +215,11 @@ void Clipboard::paste(float posX, float posY, Scene *scene) {
             edge->setEndSocket(endSock);
             endSock->addEdge(edge);
         }
-        edge->updateScale(scene->background()->viewScale());
         scene->addEdge(edge);
         pastedItem.append(edge);
     }
+    scene->restoreCopiedOutputs(pastedOutputs);
+    scene->resumeEvaluation();
     scene->pastedItems(pastedItem);
 }
 
@@ -226,8 +230,9 @@ void Clipboard::duplicate(Scene *scene) {
     QList<Node*> sel_nodes;
     QList<Edge*> sel_edges;
     QList<QQuickItem*> pastedItem;
+    QHash<Node*, CopiedOutput> duplicatedOutputs;
     for(auto item: selected) {
-        if(!(qobject_cast<AlbedoNode*>(item) || qobject_cast<MetalNode*>(item) || qobject_cast<RoughNode*>(item) || qobject_cast<NormalNode*>(item))) {
+        if(!(qobject_cast<AlbedoNode*>(item) || qobject_cast<MetalNode*>(item) || qobject_cast<RoughNode*>(item) || qobject_cast<NormalNode*>(item) || qobject_cast<HeightNode*>(item))) {
             if(qobject_cast<Node*>(item)) {
                 Node *node = qobject_cast<Node*>(item);
                 if(!node->attachedFrame() || !node->attachedFrame()->selected()) sel_nodes.append(node);
@@ -236,7 +241,7 @@ void Clipboard::duplicate(Scene *scene) {
                     if(sel_edges.contains(edge)) continue;
                     Node *startNode = qobject_cast<Node*>(edge->startSocket()->parentItem());
                     Node *endNode = qobject_cast<Node*>(edge->endSocket()->parentItem());
-                    if((startNode && startNode->selected()) && (!(qobject_cast<AlbedoNode*>(endNode) || qobject_cast<MetalNode*>(endNode) || qobject_cast<RoughNode*>(endNode) || qobject_cast<NormalNode*>(endNode)) && endNode->selected())) {
+                    if((startNode && startNode->selected()) && (!(qobject_cast<AlbedoNode*>(endNode) || qobject_cast<MetalNode*>(endNode) || qobject_cast<RoughNode*>(endNode) || qobject_cast<NormalNode*>(endNode) || qobject_cast<HeightNode*>(endNode)) && endNode->selected())) {
                         sel_edges.append(edge);
                     }
                 }
@@ -248,6 +253,7 @@ void Clipboard::duplicate(Scene *scene) {
         }
     }
 
+    scene->suspendEvaluation();
     for(auto frame: sel_frames) {
         Frame *f = new Frame(scene);
         f->setBaseX(frame->baseX() + 50);
@@ -261,8 +267,9 @@ void Clipboard::duplicate(Scene *scene) {
         QList<QQuickItem*> copiedContent;
         for(auto item: frame->contentList()) {
             Node *baseNode = qobject_cast<Node*>(item);
-            if(baseNode && !(qobject_cast<AlbedoNode*>(item) || qobject_cast<MetalNode*>(item) || qobject_cast<RoughNode*>(item) || qobject_cast<NormalNode*>(item)) && baseNode->selected()) {
+            if(baseNode && !(qobject_cast<AlbedoNode*>(item) || qobject_cast<MetalNode*>(item) || qobject_cast<RoughNode*>(item) || qobject_cast<NormalNode*>(item) || qobject_cast<HeightNode*>(item)) && baseNode->selected()) {
                 Node *copiedContentNode = nodeCopy(baseNode, scene, scene);
+                duplicatedOutputs[copiedContentNode] = CopiedOutput{baseNode, scene->outputHash(baseNode)};
                 copiedContentNode->setBaseX(baseNode->baseX() + 50);
                 copiedContentNode->setBaseY(baseNode->baseY() + 50);
                 copiedContent.append(copiedContentNode);
@@ -275,6 +282,7 @@ void Clipboard::duplicate(Scene *scene) {
     }
     for(auto node: sel_nodes) {
         Node *duplicatedNode = nodeCopy(node, scene, scene);
+        duplicatedOutputs[duplicatedNode] = CopiedOutput{node, scene->outputHash(node)};
         duplicatedNode->setBaseX(node->baseX() + 50);
         duplicatedNode->setBaseY(node->baseY() + 50);
         scene->addNode(duplicatedNode);
@@ -282,7 +290,7 @@ void Clipboard::duplicate(Scene *scene) {
         pastedItem.append(duplicatedNode);
     }
     for(auto edge: sel_edges) {
-        Edge *e = new Edge(scene);
+        Edge *e = new Edge(scene->canvas());
         e->setStartPosition(edge->startPosition() + QVector2D(50, 50)*viewScale);
         e->setEndPosition(edge->endPosition() + QVector2D(50, 50)*viewScale);
         Socket *startSock = e->findSockets(scene, e->startPosition().x(), e->startPosition().y());
@@ -296,10 +304,11 @@ void Clipboard::duplicate(Scene *scene) {
             e->setEndSocket(endSock);
             endSock->addEdge(e);
         }
-        e->updateScale(scene->background()->viewScale());
         scene->addEdge(e);
         pastedItem.append(e);
     }
+    scene->restoreCopiedOutputs(duplicatedOutputs);
+    scene->resumeEvaluation();
     scene->pastedItems(pastedItem);
 }
 
@@ -316,6 +325,7 @@ void Clipboard::clear() {
         if(edge) delete edge;
     }
     clipboard_edges.clear();
+    clipboard_outputs.clear();
 }
 
 Node *Clipboard::nodeCopy(Node *node, Scene *scene, QQuickItem *parent) {
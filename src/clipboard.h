@@ -22,6 +22,8 @@
 #ifndef CLIPBOARD_H
 #define CLIPBOARD_H
 #include <QList>
+#include <QHash>
+#include <QPointer>
 #include <QQuickItem>
 
 class Scene;
@@ -29,6 +31,11 @@ class Frame;
 class Node;
 class Edge;
 
+struct CopiedOutput {
+    QPointer<Node> source;
+    QByteArray hash;
+};
+
 class Clipboard
 {
 public:
@@ -45,6 +52,7 @@ private:
     QList<Frame*> clipboard_frames;
     QList<Node*> clipboard_nodes;
     QList<Edge*> clipboard_edges;
+    QHash<Node*, CopiedOutput> clipboard_outputs;
 };
 
 #endif // CLIPBOARD_H
@@ -20,11 +20,11 @@
  */
 
 #include "color.h"
-#include<QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include <iostream>
 
 ColorObject::ColorObject(QQuickItem *parent, QVector2D resolution, QVector3D color):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_color(color)
+    ThumbnailObject(parent), m_resolution(resolution), m_color(color)
 {
 
 }
@@ -70,14 +70,8 @@ void ColorObject::setResolution(QVector2D res) {
 
 ColorRenderer::ColorRenderer(QVector2D res): m_resolution(res){
     initializeOpenGLFunctions();
-    colorShader = new QOpenGLShaderProgram();
-    colorShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/noise.vert");
-    colorShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/color.frag");
-    colorShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    colorShader = createShaderProgram(PROGRAM_COLOR);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     textureShader->bind();
     textureShader->setUniformValue(textureShader->uniformLocation("textureSample"), 0);
     textureShader->release();
@@ -133,14 +127,8 @@ ColorRenderer::~ColorRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *ColorRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void ColorRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     ColorObject *colorItem = static_cast<ColorObject*>(item);
     if(colorItem->resUpdated) {
         colorItem->resUpdated = false;
@@ -164,7 +152,7 @@ void ColorRenderer::synchronize(QQuickFramebufferObject *item) {
     }
  }
 
-void ColorRenderer::render() {
+void ColorRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_BLEND);
     glClearColor(0.6f, 0.6f, 0.6f, 1.0f);
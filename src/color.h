@@ -22,12 +22,12 @@
 #ifndef COLOR_H
 #define COLOR_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class ColorObject: public QQuickFramebufferObject
+class ColorObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -53,13 +53,12 @@ private:
     unsigned int m_texture = 0;
 };
 
-class ColorRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class ColorRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     ColorRenderer(QVector2D res);
     ~ColorRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void createColor();
     void updateTexResolution();
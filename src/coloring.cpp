@@ -20,10 +20,10 @@
  */
 
 #include "coloring.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 
 ColoringObject::ColoringObject(QQuickItem *parent, QVector2D resolution, QVector3D color):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_color(color)
+    ThumbnailObject(parent), m_resolution(resolution), m_color(color)
 {
 }
 
@@ -78,18 +78,9 @@ QQuickFramebufferObject::Renderer *ColoringObject::createRenderer() const {
 
 ColoringRenderer::ColoringRenderer(QVector2D res):m_resolution(res) {
     initializeOpenGLFunctions();
-    coloringShader = new QOpenGLShaderProgram();
-    coloringShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    coloringShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/coloring.frag");
-    coloringShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    coloringShader = createShaderProgram(PROGRAM_COLORING);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     coloringShader->bind();
     coloringShader->setUniformValue(coloringShader->uniformLocation("sourceTexture"), 0);
     coloringShader->release();
@@ -133,14 +124,8 @@ ColoringRenderer::~ColoringRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *ColoringRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void ColoringRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     ColoringObject *coloringItem = static_cast<ColoringObject*>(item);
     if(coloringItem->resUpdated) {
         coloringItem->resUpdated = false;
@@ -165,7 +150,7 @@ void ColoringRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void ColoringRenderer::render() {
+void ColoringRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
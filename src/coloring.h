@@ -22,12 +22,12 @@
 #ifndef COLORING_H
 #define COLORING_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class ColoringObject: public QQuickFramebufferObject
+class ColoringObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -57,13 +57,12 @@ private:
     QVector3D m_color = QVector3D(1, 1, 1);
 };
 
-class ColoringRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class ColoringRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     ColoringRenderer(QVector2D res);
     ~ColoringRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void colorize();
     void updateTexResolution();
@@ -38,12 +38,7 @@ ColoringNode::ColoringNode(QQuickItem *parent, QVector2D resolution, QVector3D c
     connect(this, &Node::changeResolution, preview, &ColoringObject::setResolution);
     connect(preview, &ColoringObject::textureChanged, this, &ColoringNode::setOutput);
     connect(this, &ColoringNode::colorChanged, preview, &ColoringObject::setColor);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/ColorProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    propertiesPanel->setProperty("startColor", m_color);
-    connect(propertiesPanel, SIGNAL(colorChanged(QVector3D)), this, SLOT(updateColor(QVector3D)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/ColorProperty.qml"));
     createSockets(1, 1);
     setTitle("Coloring");
     m_socketsInput[0]->setTip("Texture");
@@ -53,6 +48,11 @@ ColoringNode::~ColoringNode() {
     delete preview;
 }
 
+void ColoringNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startColor", m_color);
+    connect(propertiesPanel, SIGNAL(colorChanged(QVector3D)), this, SLOT(updateColor(QVector3D)));
+}
+
 void ColoringNode::operation() {
     preview->selectedItem = selected();
     preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
@@ -83,7 +83,6 @@ void ColoringNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &
         QJsonArray color = json["color"].toArray();
         QVector3D c = QVector3D(color[0].toVariant().toFloat(), color[1].toVariant().toFloat(), color[2].toVariant().toFloat());
         updateColor(c);
-        propertiesPanel->setProperty("startColor", c);
     }
 }
 
@@ -45,6 +45,8 @@ public slots:
     void previewGenerated();
     void setOutput();
     void updateColor(QVector3D color);
+protected:
+    void setupPropertyPanel();
 private:
     ColoringObject *preview;
     QVector3D m_color = QVector3D(1, 1, 1);
@@ -38,12 +38,7 @@ ColorNode::ColorNode(QQuickItem *parent, QVector2D resolution, QVector3D color):
     connect(this, &ColorNode::colorChanged, preview, &ColorObject::setColor);
     connect(preview, &ColorObject::updatePreview, this, &ColorNode::updatePreview);
     connect(preview, &ColorObject::textureChanged, this, &ColorNode::operation);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/ColorProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    propertiesPanel->setProperty("startColor", m_color);
-    connect(propertiesPanel, SIGNAL(colorChanged(QVector3D)), this, SLOT(updateColor(QVector3D)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/ColorProperty.qml"));
     createSockets(0, 1);
     setTitle("Color");
 }
@@ -52,6 +47,11 @@ ColorNode::~ColorNode() {
     delete preview;
 }
 
+void ColorNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startColor", m_color);
+    connect(propertiesPanel, SIGNAL(colorChanged(QVector3D)), this, SLOT(updateColor(QVector3D)));
+}
+
 void ColorNode::operation() {
     m_socketOutput[0]->setValue(preview->texture());
 }
@@ -80,7 +80,6 @@ void ColorNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &has
         QJsonArray color = json["color"].toVariant().toJsonArray();
         QVector3D colorValue = QVector3D(color[0].toVariant().toFloat(), color[1].toVariant().toFloat(), color[2].toVariant().toFloat());
         updateColor(colorValue);
-        propertiesPanel->setProperty("startColor", colorValue);
     }
 }
 
@@ -44,6 +44,8 @@ public slots:
     void updateScale(float scale);
     void updateColor(QVector3D color);
     void previewGenerated();
+protected:
+    void setupPropertyPanel();
 private:
     ColorObject *preview;
     QVector3D m_color = QVector3D(1, 1, 1);
@@ -20,7 +20,7 @@
  */
 
 #include "colorramp.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include <iostream>
 
 bool gradientSort(QVector4D f, QVector4D s) {
@@ -28,7 +28,7 @@ bool gradientSort(QVector4D f, QVector4D s) {
 }
 
 ColorRampObject::ColorRampObject(QQuickItem *parent, QVector2D resolution, QJsonArray stops):
-    QQuickFramebufferObject (parent), m_resolution(resolution)
+    ThumbnailObject(parent), m_resolution(resolution)
 {
     m_stops.clear();
     for(auto s: stops) {
@@ -88,6 +88,7 @@ void ColorRampObject::setGradientsStops(QJsonArray stops) {
         QVector4D grad = QVector4D(g[0].toVariant().toFloat(), g[1].toVariant().toFloat(), g[2].toVariant().toFloat(), g[3].toVariant().toFloat());
         m_stops.push_back(grad);
     }
+    stopsUpdated = true;
     update();
 }
 
@@ -105,12 +106,14 @@ void ColorRampObject::gradientAdd(QVector3D color, qreal pos, int index) {
     rampedTex = true;
     QVector4D grad = QVector4D(color, pos);
     m_stops.insert(m_stops.begin() + index, grad);
+    stopsUpdated = true;
     update();
 }
 
 void ColorRampObject::positionUpdate(qreal pos, int index) {
     rampedTex = true;
     m_stops[index].setW(pos);
+    stopsUpdated = true;
     update();
 }
 
@@ -119,32 +122,26 @@ void ColorRampObject::colorUpdate(QVector3D color, int index) {
     m_stops[index].setX(color.x());
     m_stops[index].setY(color.y());
     m_stops[index].setZ(color.z());
+    stopsUpdated = true;
     update();
 }
 
 void ColorRampObject::gradientDelete(int index) {
     rampedTex = true;
     m_stops.erase(m_stops.begin() + index);
+    stopsUpdated = true;
     update();
 }
 
 ColorRampRenderer::ColorRampRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    colorRampShader = new QOpenGLShaderProgram();
-    colorRampShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    colorRampShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/colorramp.frag");
-    colorRampShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    colorRampShader = createShaderProgram(PROGRAM_COLOR_RAMP);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     colorRampShader->bind();
     colorRampShader->setUniformValue(colorRampShader->uniformLocation("sourceTexture"), 0);
     colorRampShader->setUniformValue(colorRampShader->uniformLocation("maskTexture"), 1);
+    colorRampShader->setUniformValue(colorRampShader->uniformLocation("rampTexture"), 2);
     colorRampShader->release();
     textureShader->bind();
     textureShader->setUniformValue(textureShader->uniformLocation("textureSample"), 0);
@@ -182,36 +179,41 @@ ColorRampRenderer::ColorRampRenderer(QVector2D res): m_resolution(res) {
     glBindTexture(GL_TEXTURE_2D, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    glGenBuffers(1, &gradientsSSBO);
+    glGenTextures(1, &rampTexture);
+    glBindTexture(GL_TEXTURE_1D, rampTexture);
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA16, rampSize, 0, GL_RGBA, GL_UNSIGNED_SHORT, nullptr);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_1D, 0);
 }
 
 ColorRampRenderer::~ColorRampRenderer() {
     delete colorRampShader;
     delete checkerShader;
     delete textureShader;
-}
-
-QOpenGLFramebufferObject *ColorRampRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
+    glDeleteTextures(1, &rampTexture);
 }
 
 void ColorRampRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     ColorRampObject *colorRampItem = static_cast<ColorRampObject*>(item);    
     if(colorRampItem->resUpdated) {
         colorRampItem->resUpdated = false;
         m_resolution = colorRampItem->resolution();
         updateTexResolution();
     }
+    if(colorRampItem->stopsUpdated) {
+        colorRampItem->stopsUpdated = false;
+        bakeRamp(colorRampItem->stops());
+    }
     if(colorRampItem->rampedTex) {
         colorRampItem->rampedTex = false;
 
         m_sourceTexture = colorRampItem->sourceTexture();
         if(m_sourceTexture) {
             maskTexture = colorRampItem->maskTexture();
-            colorRamp(colorRampItem->stops());
+            colorRamp();
             colorRampItem->setTexture(m_colorTexture);
             colorRampItem->updatePreview(m_colorTexture);
         }
@@ -222,7 +224,7 @@ void ColorRampRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void ColorRampRenderer::render() {
+void ColorRampRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -247,27 +249,22 @@ void ColorRampRenderer::render() {
     }
 }
 
-void ColorRampRenderer::colorRamp(const std::vector<QVector4D> &stops) {
+void ColorRampRenderer::colorRamp() {
     glBindFramebuffer(GL_FRAMEBUFFER, colorFBO);
     glViewport(0, 0, m_resolution.x(), m_resolution.y());
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glClear(GL_COLOR_BUFFER_BIT);
-    std::vector<QVector4D> gradSort = stops;
-    std::reverse(gradSort.begin(), gradSort.end());
-    std::sort(gradSort.begin(), gradSort.end(), gradientSort);
     colorRampShader->bind();
     glBindVertexArray(textureVAO);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, m_sourceTexture);
     glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, maskTexture);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, gradientsSSBO);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, gradSort.size()*sizeof (QVector4D), gradSort.data(), GL_STATIC_DRAW);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gradientsSSBO);
-    colorRampShader->setUniformValue(colorRampShader->uniformLocation("stopCount"), (int)gradSort.size());
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_1D, rampTexture);
     colorRampShader->setUniformValue(colorRampShader->uniformLocation("useMask"), maskTexture);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_1D, 0);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, 0);
     glBindVertexArray(0);
@@ -275,6 +272,39 @@ void ColorRampRenderer::colorRamp(const std::vector<QVector4D> &stops) {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void ColorRampRenderer::bakeRamp(const std::vector<QVector4D> &stops) {
+    std::vector<QVector4D> gradSort = stops;
+    std::reverse(gradSort.begin(), gradSort.end());
+    std::sort(gradSort.begin(), gradSort.end(), gradientSort);
+    std::vector<unsigned short> texels(4*rampSize);
+    int stopCount = gradSort.size();
+    int next = 1;
+    for(int i = 0; i < rampSize; ++i) {
+        float x = float(i)/(rampSize - 1);
+        QVector3D color(1.0f, 1.0f, 1.0f);
+        if(stopCount > 0) {
+            while(next < stopCount && x > gradSort[next].w()) ++next;
+            if(x <= gradSort[0].w()) {
+                color = gradSort[0].toVector3D();
+            }
+            else if(next < stopCount) {
+                float f = (x - gradSort[next - 1].w())/(gradSort[next].w() - gradSort[next - 1].w());
+                color = gradSort[next - 1].toVector3D()*(1.0f - f) + gradSort[next].toVector3D()*f;
+            }
+            else {
+                color = gradSort[stopCount - 1].toVector3D();
+            }
+        }
+        for(int c = 0; c < 3; ++c) {
+            texels[4*i + c] = qRound(qBound(0.0f, color[c], 1.0f)*65535.0f);
+        }
+        texels[4*i + 3] = 65535;
+    }
+    glBindTexture(GL_TEXTURE_1D, rampTexture);
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, rampSize, GL_RGBA, GL_UNSIGNED_SHORT, texels.data());
+    glBindTexture(GL_TEXTURE_1D, 0);
+}
+
 void ColorRampRenderer::updateTexResolution() {
     glBindTexture(GL_TEXTURE_2D, m_colorTexture);
     glTexImage2D(
@@ -22,14 +22,16 @@
 #ifndef COLORRAMP_H
 #define COLORRAMP_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include <vector>
 #include <QJsonArray>
 #include "FreeImage.h"
 
-class ColorRampObject: public QQuickFramebufferObject
+const int rampSize = 4096;
+
+class ColorRampObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -47,6 +49,7 @@ public:
     QVector2D resolution();
     void setResolution(QVector2D res);
     bool rampedTex = false;
+    bool stopsUpdated = true;
     bool selectedItem = false;
     bool resUpdated = false;
     bool texSaving = false;
@@ -67,15 +70,15 @@ private:
     std::vector<QVector4D> m_stops;
 };
 
-class ColorRampRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core{
+class ColorRampRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core{
 public:
     ColorRampRenderer(QVector2D res);
     ~ColorRampRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
-    void colorRamp(const std::vector<QVector4D> &stops);
+    void colorRamp();
+    void bakeRamp(const std::vector<QVector4D> &stops);
     void updateTexResolution();
     void saveTexture(QString fileName);
     QVector2D m_resolution;
@@ -84,7 +87,7 @@ private:
     unsigned int m_sourceTexture = 0;
     unsigned int maskTexture = 0;
     unsigned int textureVAO = 0;
-    unsigned int gradientsSSBO;
+    unsigned int rampTexture = 0;
     QOpenGLShaderProgram *colorRampShader;
     QOpenGLShaderProgram *checkerShader;
     QOpenGLShaderProgram *textureShader;
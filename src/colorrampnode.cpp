@@ -38,26 +38,26 @@ ColorRampNode::ColorRampNode(QQuickItem *parent, QVector2D resolution, QJsonArra
     connect(this, &Node::changeResolution, preview, &ColorRampObject::setResolution);
     connect(preview, &ColorRampObject::textureChanged, this, &ColorRampNode::setOutput);
     connect(preview, &ColorRampObject::updatePreview, this, &ColorRampNode::updatePreview);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/ColorRampProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    connect(propertiesPanel, SIGNAL(gradientStopAdded(QVector3D, qreal, int)), preview, SLOT(gradientAdd(QVector3D, qreal, int)));
-    connect(propertiesPanel, SIGNAL(positionChanged(qreal, int)), preview, SLOT(positionUpdate(qreal, int)));
-    connect(propertiesPanel, SIGNAL(colorChanged(QVector3D, int)), preview, SLOT(colorUpdate(QVector3D, int)));
-    connect(propertiesPanel, SIGNAL(gradientStopDeleted(int)), preview, SLOT(gradientDelete(int)));
-    connect(this, SIGNAL(stopsChanged(QVariant)), propertiesPanel, SIGNAL(gradientsStopsChanged(QVariant)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/ColorRampProperty.qml"));
     createSockets(2, 1);
     setTitle("Color Ramp");
     m_socketsInput[0]->setTip("Texture");
     m_socketsInput[1]->setTip("Mask");
-    stopsChanged(QVariant(stops));
 }
 
 ColorRampNode::~ColorRampNode() {
     delete preview;
 }
 
+void ColorRampNode::setupPropertyPanel() {
+    connect(propertiesPanel, SIGNAL(gradientStopAdded(QVector3D, qreal, int)), preview, SLOT(gradientAdd(QVector3D, qreal, int)));
+    connect(propertiesPanel, SIGNAL(positionChanged(qreal, int)), preview, SLOT(positionUpdate(qreal, int)));
+    connect(propertiesPanel, SIGNAL(colorChanged(QVector3D, int)), preview, SLOT(colorUpdate(QVector3D, int)));
+    connect(propertiesPanel, SIGNAL(gradientStopDeleted(int)), preview, SLOT(gradientDelete(int)));
+    connect(this, SIGNAL(stopsChanged(QVariant)), propertiesPanel, SIGNAL(gradientsStopsChanged(QVariant)));
+    stopsChanged(QVariant(stops()));
+}
+
 void ColorRampNode::operation() {
     preview->selectedItem = selected();
     preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
@@ -89,11 +89,9 @@ void ColorRampNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *>
 }
 
 QJsonArray ColorRampNode::stops() const{
-    QList<QVariant> gradientsStops = propertiesPanel->property("gradientStops").toList();
     QJsonArray stops;
-    for(auto s: gradientsStops) {
-        QJsonArray i = s.toJsonArray();
-        stops.push_back(i);
+    for(auto s: preview->stops()) {
+        stops.push_back(QJsonArray{s.x(), s.y(), s.z(), s.w()});
     }
     return stops;
 }
@@ -43,6 +43,8 @@ public slots:
     void updateScale(float scale);
     void previewGenerated();
     void setOutput();
+protected:
+    void setupPropertyPanel();
 private:
     ColorRampObject *preview;
 };
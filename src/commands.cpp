@@ -25,8 +25,8 @@
 #include "scene.h"
 #include <iostream>
 
-MoveCommand::MoveCommand(QList<QQuickItem *> nodes, QVector2D movVector, Frame *frame, QUndoCommand *parent):
-QUndoCommand(parent), m_nodes(nodes), m_movVector(movVector), m_frame(frame)
+MoveCommand::MoveCommand(QList<QQuickItem *> nodes, QVector2D movVector, Scene *scene, Frame *frame, QUndoCommand *parent):
+QUndoCommand(parent), m_nodes(nodes), m_movVector(movVector), m_scene(scene), m_frame(frame)
 {    
     for(auto item: m_nodes) {
         if(qobject_cast<Node*>(item)) {
@@ -37,6 +37,9 @@ QUndoCommand(parent), m_nodes(nodes), m_movVector(movVector), m_frame(frame)
             Frame *frame = qobject_cast<Frame*>(item);
             m_newPos.push_back(QVector2D(frame->baseX(), frame->baseY()));
         }
+        else {
+            m_newPos.push_back(QVector2D());
+        }
     }
     if(m_frame) {
         m_oldFrameX = m_frame->baseX();
@@ -48,22 +51,19 @@ QUndoCommand(parent), m_nodes(nodes), m_movVector(movVector), m_frame(frame)
 
 MoveCommand::~MoveCommand() {
     m_nodes.clear();
+    m_scene = nullptr;
 }
 
 void MoveCommand::undo() {
-    for(auto item: m_nodes) {
-        if(qobject_cast<Node*>(item)) {
+    if(m_frame) {
+        QList<QQuickItem*> nodesFromFrame;
+        for(auto item: m_nodes) {
             Node *node = qobject_cast<Node*>(item);
-            if(m_frame && node->attachedFrame() == m_frame) m_frame->removeItem(node);
-            node->setBaseX(node->baseX() - m_movVector.x());
-            node->setBaseY(node->baseY() - m_movVector.y());
-        }
-        else if(qobject_cast<Frame*>(item)) {
-            Frame *frame = qobject_cast<Frame*>(item);
-            frame->setBaseX(frame->baseX() - m_movVector.x());
-            frame->setBaseY(frame->baseY() - m_movVector.y());
+            if(node && node->attachedFrame() == m_frame) nodesFromFrame.push_back(node);
         }
+        m_frame->removeItems(nodesFromFrame);
     }
+    m_scene->moveItems(m_nodes, -m_movVector);
     if(m_frame) {
         m_frame->setBaseX(m_oldFrameX);
         m_frame->setBaseY(m_oldFrameY);
@@ -73,22 +73,15 @@ void MoveCommand::undo() {
 }
 
 void MoveCommand::redo() {
-    QList<QQuickItem*> nodesToFrame;
-    for(int i = 0; i < m_nodes.count(); ++i) {
-        QQuickItem *item = m_nodes[i];
-        if(qobject_cast<Node*>(item)) {
+    m_scene->moveItems(m_nodes, m_newPos);
+    if(m_frame) {
+        QList<QQuickItem*> nodesToFrame;
+        for(auto item: m_nodes) {
             Node *n = qobject_cast<Node*>(item);
-            n->setBaseX(m_newPos[i].x());
-            n->setBaseY(m_newPos[i].y());
-            if(m_frame && !n->attachedFrame()) nodesToFrame.push_back(n);
-        }
-        else if(qobject_cast<Frame*>(item)) {
-            Frame *f = qobject_cast<Frame*>(item);
-            f->setBaseX(m_newPos[i].x());
-            f->setBaseY(m_newPos[i].y());
+            if(n && !n->attachedFrame()) nodesToFrame.push_back(n);
         }
+        m_frame->addNodes(nodesToFrame);
     }
-    if(m_frame) m_frame->addNodes(nodesToFrame);
 }
 
 AddNode::AddNode(Node *node, Scene *scene, QUndoCommand *parent): QUndoCommand (parent), m_scene(scene), m_node(node)
@@ -107,7 +100,7 @@ void AddNode::undo() {
 
 void AddNode::redo() {
     m_scene->addNode(m_node);
-    m_node->setParentItem(m_scene);
+    m_node->setParentItem(m_scene->canvas());
     m_node->generatePreview();
 }
 
@@ -133,7 +126,7 @@ void AddEdge::redo() {
     m_edge->endSocket()->addEdge(m_edge);
     m_edge->setStartPosition(m_edge->startSocket()->globalPos());
     m_edge->setEndPosition(m_edge->endSocket()->globalPos());
-    m_edge->setParentItem(m_scene);
+    m_edge->setParentItem(m_scene->canvas());
     m_edge->endSocket()->setValue(m_edge->startSocket()->value());
 }
 
@@ -154,7 +147,7 @@ void AddFrame::undo() {
 
 void AddFrame::redo() {
     m_scene->addFrame(m_frame);
-    m_frame->setParentItem(m_scene);
+    m_frame->setParentItem(m_scene->canvas());
 }
 
 DeleteCommand::DeleteCommand(QList<QQuickItem*> items, Scene *scene, QUndoCommand *parent): QUndoCommand (parent),
@@ -172,7 +165,7 @@ void DeleteCommand::undo() {
         if(qobject_cast<Node*>(item)) {
             Node *node = qobject_cast<Node*>(item);
             m_scene->addNode(node);
-            node->setParentItem(m_scene);
+            node->setParentItem(m_scene->canvas());
             m_scene->addSelected(node);
             node->generatePreview();
         }
@@ -183,13 +176,13 @@ void DeleteCommand::undo() {
             edge->endSocket()->addEdge(edge);
             edge->setStartPosition(edge->startSocket()->globalPos());
             edge->setEndPosition(edge->endSocket()->globalPos());
-            edge->setParentItem(m_scene);
+            edge->setParentItem(m_scene->canvas());
             edge->endSocket()->setValue(edge->startSocket()->value());
         }
         else if(qobject_cast<Frame*>(item)) {
             Frame *frame = qobject_cast<Frame*>(item);
             m_scene->addFrame(frame);
-            frame->setParentItem(m_scene);
+            frame->setParentItem(m_scene->canvas());
             m_scene->addSelected(frame);
             for(auto item: frame->contentList()) {
                 if(qobject_cast<Node*>(item)) {
@@ -352,44 +345,54 @@ void PasteCommand::redo() {
     for(auto item: m_pastedItems) {
         if(qobject_cast<Node*>(item)) {
             Node *node = qobject_cast<Node*>(item);
-            node->setParentItem(m_scene);
+            node->setParentItem(m_scene->canvas());
             node->setSelected(true);
             m_scene->addNode(node);
             m_scene->addSelected(node);
-            node->generatePreview();
+            // copies that started from their source's output keep it on the first paste
+            if(m_applied || !node->outputRestored()) node->generatePreview();
         }
         else if(qobject_cast<Edge*>(item)) {
             Edge *edge = qobject_cast<Edge*>(item);
-            edge->setParentItem(m_scene);
+            edge->setParentItem(m_scene->canvas());
             m_scene->addEdge(edge);
         }
         else if(qobject_cast<Frame*>(item)) {
             Frame *frame = qobject_cast<Frame*>(item);
-            frame->setParentItem(m_scene);
+            frame->setParentItem(m_scene->canvas());
             frame->setSelected(true);
             m_scene->addFrame(frame);
             m_scene->addSelected(frame);
         }
     }
+    m_applied = true;
 }
 
 PropertyChangeCommand::PropertyChangeCommand(Node* node, const char* propName, QVariant newValue,
-                                             QVariant oldValue, QUndoCommand *parent):
-    QUndoCommand (parent), m_node(node), m_propName(propName), m_oldValue(oldValue), m_newValue(newValue) {
+                                             QVariant oldValue, Scene *scene, QUndoCommand *parent):
+    QUndoCommand (parent), m_node(node), m_propName(propName), m_oldValue(oldValue), m_newValue(newValue), m_scene(scene) {
 
 }
 
 PropertyChangeCommand::~PropertyChangeCommand() {
     m_node = nullptr;
     m_propName = nullptr;
+    m_scene = nullptr;
 }
 
 void PropertyChangeCommand::undo() {
-    m_node->setPropertyOnPanel(m_propName, m_oldValue);
+    m_scene->applyNodeProperty(m_node, m_propName, m_oldValue);
 }
 
 void PropertyChangeCommand::redo() {
-    m_node->setPropertyOnPanel(m_propName, m_newValue);
+    if(m_applied) {
+        m_scene->applyNodeProperty(m_node, m_propName, m_newValue);
+    }
+    else {
+        // pushed after the edit was already rendered, only keep its outputs
+        m_applied = true;
+        m_scene->retainOutputs(m_node);
+    }
 }
 
 MoveEdgeCommand::MoveEdgeCommand(Edge *edge, Socket *oldEndSocket, Socket *newEndSocket,
@@ -33,7 +33,7 @@ class Socket;
 
 class MoveCommand: public QUndoCommand {
 public:
-    MoveCommand(QList<QQuickItem*> nodes, QVector2D movVector, Frame *frame = nullptr, QUndoCommand *parent = nullptr);
+    MoveCommand(QList<QQuickItem*> nodes, QVector2D movVector, Scene *scene, Frame *frame = nullptr, QUndoCommand *parent = nullptr);
     ~MoveCommand();
     void undo();
     void redo();
@@ -41,6 +41,7 @@ private:
     QList<QQuickItem*> m_nodes;
     QList<QVector2D> m_newPos;
     QVector2D m_movVector;
+    Scene *m_scene;
     Frame *m_frame;
     float m_oldFrameX;
     float m_oldFrameY;
@@ -113,11 +114,12 @@ public:
 private:
     Scene *m_scene;
     QList<QQuickItem*> m_pastedItems;
+    bool m_applied = false;
 };
 
 class PropertyChangeCommand: public QUndoCommand {
 public:
-    PropertyChangeCommand(Node* node, const char *propName, QVariant newValue, QVariant oldValue, QUndoCommand *parent = nullptr);
+    PropertyChangeCommand(Node* node, const char *propName, QVariant newValue, QVariant oldValue, Scene *scene, QUndoCommand *parent = nullptr);
     ~PropertyChangeCommand();
     void undo();
     void redo();
@@ -126,6 +128,8 @@ private:
     const char *m_propName;
     QVariant m_oldValue;
     QVariant m_newValue;
+    Scene *m_scene = nullptr;
+    bool m_applied = false;
 };
 
 class MoveEdgeCommand: public QUndoCommand {
@@ -0,0 +1,65 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "components.h"
+#include <QQmlComponent>
+#include <QHash>
+
+static QQmlEngine *componentsEngine = nullptr;
+static QHash<QUrl, QQmlComponent*> components;
+
+void setComponentsEngine(QQmlEngine *engine) {
+    componentsEngine = engine;
+}
+
+QQuickItem *createItem(const QUrl &url, QQuickItem *parent) {
+    // the engine is owned by main(), items must not be created before it is set
+    Q_ASSERT_X(componentsEngine, "createItem", "setComponentsEngine() was not called");
+    if(!componentsEngine) {
+        qWarning("No QML engine to create %s", qPrintable(url.toString()));
+        return nullptr;
+    }
+    QQmlComponent *component = components.value(url);
+    if(!component) {
+        // compiled once, every node, socket and panel is instantiated from the cached component
+        component = new QQmlComponent(componentsEngine, url, QQmlComponent::PreferSynchronous, componentsEngine);
+        components.insert(url, component);
+    }
+    if(component->isError()) {
+        qWarning("Couldn`t create %s: %s", qPrintable(url.toString()), qPrintable(component->errorString()));
+        return nullptr;
+    }
+    QObject *object = component->beginCreate(componentsEngine->rootContext());
+    if(!object) {
+        qWarning("Couldn`t create %s: %s", qPrintable(url.toString()), qPrintable(component->errorString()));
+        return nullptr;
+    }
+    QQuickItem *item = qobject_cast<QQuickItem*>(object);
+    if(item && parent) item->setParentItem(parent);
+    component->completeCreate();
+    if(!item) {
+        qWarning("%s is not an Item", qPrintable(url.toString()));
+        delete object;
+        return nullptr;
+    }
+    QQmlEngine::setObjectOwnership(object, QQmlEngine::CppOwnership);
+    return item;
+}
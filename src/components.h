@@ -0,0 +1,31 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QUrl>
+
+void setComponentsEngine(QQmlEngine *engine);
+QQuickItem *createItem(const QUrl &url, QQuickItem *parent = nullptr);
+
+#endif // COMPONENTS_H
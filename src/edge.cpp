@@ -24,15 +24,17 @@
 #include <iostream>
 #include <QQmlEngine>
 #include <QQmlProperty>
+#include <QPainterPath>
 
 Edge::Edge(QQuickItem *parent): QQuickItem(parent)
 {
-    grEdge = new CubicBezier(this);
-    if(parent) {
-        Scene *scene = reinterpret_cast<Scene*>(parent);
-        connect(scene->background(), &BackgroundObject::scaleChanged, this, &Edge::updateScale);
-        grEdge->setLineWidth(3.0f*scene->background()->viewScale());
+    Scene *scene = Scene::sceneOf(parent);
+    if(scene) {
+        m_batch = scene->edgeBatch();
+        m_batch->addEdge(this);
     }
+    connect(this, &QQuickItem::visibleChanged, this, &Edge::updateBatch);
+    connect(this, &QQuickItem::parentChanged, this, &Edge::updateBatch);
     setZ(2);
 }
 
@@ -44,22 +46,34 @@ Edge::Edge(const Edge &edge):Edge() {
 Edge::~Edge() {
     m_startSocket = nullptr;
     m_endSocket = nullptr;
-    delete grEdge;
+    if(m_batch) m_batch->removeEdge(this);
 }
 
 bool Edge::intersectWith(QPointF p1, QPointF p2) {
+    QRectF bounds = curveBounds();
+    if(std::max(p1.x(), p2.x()) < bounds.left() || std::min(p1.x(), p2.x()) > bounds.right() ||
+       std::max(p1.y(), p2.y()) < bounds.top() || std::min(p1.y(), p2.y()) > bounds.bottom()) {
+        return false;
+    }
     QPainterPath cutLine(p1);
     cutLine.lineTo(p2);
-    QPointF startPoint = grEdge->p1();
-    QPointF c1 = grEdge->p2();
-    QPointF c2 = grEdge->p3();
-    QPointF endPoint = grEdge->p4();
+    float offset = 0.5f*std::max(std::abs(m_startPos.x() - m_endPos.x()), 0.01f);
     QPainterPath edgeLine(QPointF(m_startPos.x(), m_startPos.y()));
-    edgeLine.cubicTo(QPointF(m_startPos.x() + 0.5*grEdge->width(), m_startPos.y()), QPointF(m_endPos.x() -
-                     0.5*grEdge->width(), m_endPos.y()), QPointF(m_endPos.x(), m_endPos.y()));
+    edgeLine.cubicTo(QPointF(m_startPos.x() + offset, m_startPos.y()), QPointF(m_endPos.x() -
+                     offset, m_endPos.y()), QPointF(m_endPos.x(), m_endPos.y()));
     return cutLine.intersects(edgeLine);
 }
 
+QRectF Edge::curveBounds() const {
+    // the control points stick out horizontally by half the width
+    float w = std::abs(m_startPos.x() - m_endPos.x());
+    float left = std::min(m_startPos.x(), m_endPos.x()) - 0.5f*w;
+    float right = std::max(m_startPos.x(), m_endPos.x()) + 0.5f*w;
+    float top = std::min(m_startPos.y(), m_endPos.y());
+    float bottom = std::max(m_startPos.y(), m_endPos.y());
+    return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
 QVector2D Edge::startPosition() {
     return m_startPos;
 }
@@ -68,19 +82,8 @@ void Edge::setStartPosition(QVector2D pos) {
     m_startPos = pos;
     setX(std::min(m_startPos.x(), m_endPos.x()));
     setY(std::min(m_startPos.y(), m_endPos.y()));
-    float w = std::abs(m_startPos.x() - m_endPos.x());
-    float h = std::abs(m_startPos.y() - m_endPos.y());
-    grEdge->setWidth(std::max(w, 0.01f));
-    grEdge->setHeight(std::max(h, 0.01f));
-    float p1X = w > 0.0f ? (pos.x() - x())/w : 0.0f;
-    float p1Y = h > 0.0f ? (pos.y() - y())/h : 0.0f;
-    float offset = 0.5f;
-    grEdge->setP1(QPointF(p1X, p1Y));
-    grEdge->setP2(QPointF(p1X + offset, p1Y));
-    grEdge->setP4(QPointF(1.0f - p1X, 1.0f - p1Y));
-    grEdge->setP3(QPointF(1.0f - offset - p1X, 1.0f - p1Y));
+    updateBatch();
     emit startPositionChanged(pos);
-
 }
 
 QVector2D Edge::endPosition() {
@@ -91,17 +94,7 @@ void Edge::setEndPosition(QVector2D pos) {
     m_endPos = pos;
     setX(std::min(m_startPos.x(), m_endPos.x()));
     setY(std::min(m_startPos.y(), m_endPos.y()));
-    float w = std::abs(m_startPos.x() - m_endPos.x());
-    float h = std::abs(m_startPos.y() - m_endPos.y());
-    grEdge->setWidth(std::max(w, 0.01f));
-    grEdge->setHeight(std::max(h, 0.01f));
-    float p4X = w > 0.0f ? (pos.x() - x())/w : 0.0f;
-    float p4Y = h > 0.0f ? (pos.y() - y())/h : 0.0f;
-    float offset = 0.5f;
-    grEdge->setP4(QPointF(p4X, p4Y));
-    grEdge->setP3(QPointF(p4X - offset, p4Y));
-    grEdge->setP1(QPointF(1.0f - p4X, 1.0f - p4Y));
-    grEdge->setP2(QPointF(1.0f + offset - p4X, 1.0f - p4Y));
+    updateBatch();
     emit endPositionChanged(pos);
 }
 
@@ -143,10 +136,10 @@ void Edge::setEndSocket(Socket *socket) {
 }
 
 Socket* Edge::findSockets(Scene *scene, float x, float y) {
-    QQuickItem *item = scene->childAt(x, y);
-    if(qobject_cast<Node*>(item)) {
-        Node *n = qobject_cast<Node*>(item);
-        QPointF childPos = n->mapFromItem(scene, QPointF(x, y));
+    QPointF scenePos = scene->canvas()->mapToItem(scene, QPointF(x, y));
+    Node *n = scene->nodeAt(scenePos.x(), scenePos.y());
+    if(n) {
+        QPointF childPos = n->mapFromItem(scene->canvas(), QPointF(x, y));
         QQuickItem *child = n->childAt(childPos.x(), childPos.y());
         if(qobject_cast<Socket*>(child)) {
             Socket *s = qobject_cast<Socket*>(child);
@@ -162,7 +155,6 @@ bool Edge::selected() {
 
 void Edge::setSelected(bool selected) {
     m_selected = selected;
-    grEdge->setProperty("selected", m_selected);
 }
 
 void Edge::serialize(QJsonObject &json) const {
@@ -190,13 +182,12 @@ void Edge::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
     }
 }
 
-void Edge::updateScale(float scale) {
-    m_scale = scale;
-    grEdge->setLineWidth(std::max(3.0f*scale, 1.0f));
+void Edge::updateBatch() {
+    if(m_batch) m_batch->updateEdge(this);
 }
 
 void Edge::pressedEdge(bool control) {
-    Scene *scene = reinterpret_cast<Scene*>(parentItem());
+    Scene *scene = Scene::sceneOf(this);
     if(control) {
         setSelected(!m_selected);
         if(m_selected) {
@@ -22,9 +22,9 @@
 #ifndef EDGE_H
 #define EDGE_H
 #include <QQuickItem>
-#include <QQuickView>
 #include <QJsonObject>
-#include "cubicbezier.h"
+#include <QPointer>
+#include "edgebatch.h"
 
 class Socket;
 class Scene;
@@ -40,6 +40,7 @@ public:
     Edge(const Edge &edge);
     ~Edge();
     bool intersectWith(QPointF p1, QPointF p2);
+    QRectF curveBounds() const;
     QVector2D startPosition();
     void setStartPosition(QVector2D pos);
     QVector2D endPosition();
@@ -57,15 +58,14 @@ signals:
     void startPositionChanged(QVector2D pos);
     void endPositionChanged(QVector2D pos);
 public slots:
-    void updateScale(float scale);
+    void updateBatch();
     void pressedEdge(bool controlModifier);
 private:
-    CubicBezier *grEdge;
+    QPointer<EdgeBatch> m_batch;
     QVector2D m_startPos;
     QVector2D m_endPos;
     Socket *m_startSocket = nullptr;
     Socket *m_endSocket = nullptr;
-    float m_scale = 1.0f;
     bool m_selected = false;
 };
 
@@ -0,0 +1,145 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "edgebatch.h"
+#include "edge.h"
+#include <QtQuick/qsgnode.h>
+#include <QtQuick/qsgflatcolormaterial.h>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+static const int edgeVertexCount = 2*(edgePointCount - 1);
+
+EdgeBatch::EdgeBatch(QQuickItem *parent): QQuickItem (parent)
+{
+    setFlag(ItemHasContents, true);
+    setZ(2);
+}
+
+QSGNode *EdgeBatch::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) {
+    QSGGeometryNode *node = nullptr;
+    QSGGeometry *geometry = nullptr;
+    if(!oldNode) {
+        node = new QSGGeometryNode();
+        geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawLines);
+        geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        QSGFlatColorMaterial *material = new QSGFlatColorMaterial();
+        material->setColor(QColor(104, 163, 219));
+        node->setMaterial(material);
+        node->setFlag(QSGNode::OwnsMaterial);
+        m_rebuild = true;
+    }
+    else {
+        node = static_cast<QSGGeometryNode*>(oldNode);
+        geometry = node->geometry();
+    }
+    geometry->setLineWidth(m_lineWidth);
+    if(geometry->vertexCount() != m_capacity*edgeVertexCount) {
+        geometry->allocate(m_capacity*edgeVertexCount);
+        m_rebuild = true;
+    }
+    void *vertexData = geometry->vertexData();
+    if(m_rebuild) {
+        std::memset(vertexData, 0, geometry->vertexCount()*geometry->sizeOfVertex());
+        for(auto it = m_slots.constBegin(); it != m_slots.constEnd(); ++it) {
+            writeEdge(it.key(), it.value(), vertexData);
+        }
+        m_rebuild = false;
+    }
+    else {
+        for(int slot: m_clearedSlots) {
+            clearSlot(slot, vertexData);
+        }
+        for(Edge *edge: m_dirtyEdges) {
+            if(m_slots.contains(edge)) writeEdge(edge, m_slots[edge], vertexData);
+        }
+    }
+    m_clearedSlots.clear();
+    m_dirtyEdges.clear();
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+void EdgeBatch::addEdge(Edge *edge) {
+    if(m_slots.contains(edge)) return;
+    int slot;
+    if(!m_freeSlots.isEmpty()) {
+        slot = m_freeSlots.takeLast();
+    }
+    else {
+        slot = m_slotCount++;
+        if(m_slotCount > m_capacity) m_capacity = std::max(64, 2*m_capacity);
+    }
+    m_slots[edge] = slot;
+    m_dirtyEdges.insert(edge);
+    update();
+}
+
+void EdgeBatch::removeEdge(Edge *edge) {
+    if(!m_slots.contains(edge)) return;
+    int slot = m_slots.take(edge);
+    m_freeSlots.append(slot);
+    m_clearedSlots.append(slot);
+    m_dirtyEdges.remove(edge);
+    update();
+}
+
+void EdgeBatch::updateEdge(Edge *edge) {
+    if(!m_slots.contains(edge)) return;
+    m_dirtyEdges.insert(edge);
+    update();
+}
+
+void EdgeBatch::updateScale(float scale) {
+    m_lineWidth = std::max(3.0f*scale, 1.0f);
+    update();
+}
+
+void EdgeBatch::writeEdge(Edge *edge, int slot, void *vertexData) {
+    if(!edge->parentItem() || !edge->isVisible()) {
+        clearSlot(slot, vertexData);
+        return;
+    }
+    QSGGeometry::Point2D *vertices = static_cast<QSGGeometry::Point2D*>(vertexData) + slot*edgeVertexCount;
+    QPointF p1 = edge->startPosition().toPointF();
+    QPointF p4 = edge->endPosition().toPointF();
+    float offset = 0.5f*std::max(static_cast<float>(std::abs(p4.x() - p1.x())), 0.01f);
+    QPointF p2 = p1 + QPointF(offset, 0);
+    QPointF p3 = p4 - QPointF(offset, 0);
+    QPointF last = p1;
+    for(int i = 1; i < edgePointCount; ++i) {
+        qreal t = i/qreal(edgePointCount - 1);
+        qreal invt = 1 - t;
+        QPointF pos = invt*invt*invt*p1 + 3*invt*invt*t*p2 + 3*invt*t*t*p3 + t*t*t*p4;
+        vertices[2*i - 2].set(last.x(), last.y());
+        vertices[2*i - 1].set(pos.x(), pos.y());
+        last = pos;
+    }
+}
+
+void EdgeBatch::clearSlot(int slot, void *vertexData) {
+    QSGGeometry::Point2D *vertices = static_cast<QSGGeometry::Point2D*>(vertexData) + slot*edgeVertexCount;
+    std::memset(vertices, 0, edgeVertexCount*sizeof(QSGGeometry::Point2D));
+}
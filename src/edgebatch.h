@@ -0,0 +1,57 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef EDGEBATCH_H
+#define EDGEBATCH_H
+
+#include <QQuickItem>
+#include <QHash>
+#include <QSet>
+
+class Edge;
+
+const int edgePointCount = 64;
+
+class EdgeBatch: public QQuickItem
+{
+    Q_OBJECT
+public:
+    EdgeBatch(QQuickItem *parent = nullptr);
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *);
+    void addEdge(Edge *edge);
+    void removeEdge(Edge *edge);
+    void updateEdge(Edge *edge);
+public slots:
+    void updateScale(float scale);
+private:
+    void writeEdge(Edge *edge, int slot, void *vertexData);
+    void clearSlot(int slot, void *vertexData);
+    QHash<Edge*, int> m_slots;
+    QVector<int> m_freeSlots;
+    QSet<Edge*> m_dirtyEdges;
+    QVector<int> m_clearedSlots;
+    int m_slotCount = 0;
+    int m_capacity = 0;
+    bool m_rebuild = true;
+    float m_lineWidth = 3.0f;
+};
+
+#endif // EDGEBATCH_H
@@ -22,6 +22,7 @@
 #include "frame.h"
 #include "scene.h"
 #include <iostream>
+#include <QQuickWindow>
 #include "albedonode.h"
 #include "metalnode.h"
 #include "roughnode.h"
@@ -52,17 +53,17 @@ Frame::Frame(QQuickItem *parent): QQuickItem (parent)
     setFlag(ItemAcceptsDrops, true);
     setWidth(200);
     setHeight(100);
-    m_view = new QQuickView();
-    m_view->setSource(QUrl(QStringLiteral("qrc:/qml/NodeFrame.qml")));
-    m_grFrame = qobject_cast<QQuickItem *>(m_view->rootObject());
-    m_grFrame->setParentItem(this);
+    m_grFrame = createItem(QUrl(QStringLiteral("qrc:/qml/NodeFrame.qml")), this);
+    if(!m_grFrame) {
+        m_grFrame = new QQuickItem(this);
+        return;
+    }
     connect(this, SIGNAL(nameInput()), m_grFrame, SLOT(createNameInput()));
     connect(m_grFrame, SIGNAL(titleChanged(QString, QString)), this, SLOT(titleChanged(QString, QString)));
 }
 
 Frame::~Frame() {
     delete m_grFrame;
-    delete m_view;
 }
 
 float Frame::baseX() {
@@ -84,7 +85,7 @@ void Frame::setBaseX(float x) {
         }*/
     }
     m_baseX = x;
-    setX(x*m_scale - m_pan.x());
+    setX(x*m_scale);
 }
 
 float Frame::baseY() {
@@ -106,7 +107,21 @@ void Frame::setBaseY(float y) {
         }*/
     }
     m_baseY = y;
-    setY(y*m_scale - m_pan.y());
+    setY(y*m_scale);
+}
+
+void Frame::setBasePosition(QVector2D pos) {
+    QVector2D offset = pos - QVector2D(m_baseX, m_baseY);
+    for(QQuickItem *item: m_content) {
+        if(qobject_cast<Node*>(item)) {
+            Node *n = qobject_cast<Node*>(item);
+            if(n->selected()) continue;
+            n->setBasePosition(QVector2D(n->baseX(), n->baseY()) + offset);
+        }
+    }
+    m_baseX = pos.x();
+    m_baseY = pos.y();
+    setPosition(QPointF(m_baseX*m_scale, m_baseY*m_scale));
 }
 
 float Frame::baseWidth() {
@@ -135,18 +150,10 @@ void Frame::setTitle(QString title) {
     m_grFrame->setProperty("frameName", title);
 }
 
-QVector2D Frame::pan() {
-    return m_pan;
-}
-
-void Frame::setPan(QVector2D pan) {
-    m_pan = pan;
-    setX(m_baseX*m_scale - pan.x());
-    setY(m_baseY*m_scale - pan.y());
-}
-
 void Frame::setScaleView(float scale) {
     m_scale = scale;
+    setX(m_baseX*scale);
+    setY(m_baseY*scale);
     setWidth(m_baseWidth*scale);
     setHeight(m_baseHeight*scale);
     m_grFrame->setProperty("scaleView", scale);
@@ -165,8 +172,8 @@ void Frame::resizeByContent() {
     }
     setX(minX - 10*m_scale);
     setY(minY - 45*m_scale);
-    m_baseX = (x() + m_pan.x())/m_scale;
-    m_baseY = (y() + m_pan.y())/m_scale;
+    m_baseX = x()/m_scale;
+    m_baseY = y()/m_scale;
     setWidth(maxX - minX + 20*m_scale);
     setHeight(maxY - minY + 65*m_scale);
     m_baseWidth = width()/m_scale;
@@ -182,7 +189,7 @@ void Frame::mousePressEvent(QMouseEvent *event) {
         m_oldX = m_baseX;
         m_oldY = m_baseY;
         m_moved = false;
-        Scene *scene = qobject_cast<Scene*>(parentItem());
+        Scene *scene = Scene::sceneOf(this);
         if(event->modifiers() == Qt::ControlModifier) {
            setSelected(!m_selected);
            QList<QQuickItem*> selectedList = scene->selectedList();
@@ -212,7 +219,7 @@ void Frame::mouseMoveEvent(QMouseEvent *event) {
         QPointF point = mapToItem(parentItem(), QPointF(event->pos().x(), event->pos().y()));
         float offsetX = point.x() - x();
         float offsetY = point.y() - y();
-        Scene *scene = qobject_cast<Scene*>(parentItem());
+        Scene *scene = Scene::sceneOf(this);
         float offX = 0;
         float offY = 0;
         float offW = 0;
@@ -220,12 +227,12 @@ void Frame::mouseMoveEvent(QMouseEvent *event) {
         switch (currentResize) {
         case LEFT:
             if(width() - offsetX > m_minWidth*m_scale) {
-                offX = (point.x() + m_pan.x())/m_scale - m_baseX;
+                offX = point.x()/m_scale - m_baseX;
                 offW = (width() - offsetX)/m_scale - m_baseWidth;
             }
             else {
                 offsetX = width() - m_minWidth*m_scale;
-                offX = (x() + offsetX + m_pan.x())/m_scale - m_baseX;
+                offX = (x() + offsetX)/m_scale - m_baseX;
                 offW = (width() - offsetX)/m_scale - m_baseWidth;
             }
             scene->resizedFrame(this, offX, offY, offW, offH);
@@ -237,12 +244,12 @@ void Frame::mouseMoveEvent(QMouseEvent *event) {
             break;
         case TOP:
             if(height() - offsetY > m_minHeight*m_scale) {
-                offY = (point.y() + m_pan.y())/m_scale - m_baseY;
+                offY = point.y()/m_scale - m_baseY;
                 offH = (height() - offsetY)/m_scale - m_baseHeight;
             }
             else {
                 offsetY = height() - m_minHeight*m_scale;
-                offY = (y() + offsetY + m_pan.y())/m_scale - m_baseY;
+                offY = (y() + offsetY)/m_scale - m_baseY;
                 offH = (height() - offsetY)/m_scale - m_baseHeight;
             }
             scene->resizedFrame(this, offX, offY, offW, offH);
@@ -254,21 +261,21 @@ void Frame::mouseMoveEvent(QMouseEvent *event) {
             break;
         case TOPLEFT:
             if(width() - offsetX > m_minWidth*m_scale) {
-                offX = (point.x() + m_pan.x())/m_scale - m_baseX;
+                offX = point.x()/m_scale - m_baseX;
                 offW = (width() - offsetX)/m_scale - m_baseWidth;
             }
             else {
                 offsetX = width() - m_minWidth*m_scale;
-                offX = (x() + offsetX + m_pan.x())/m_scale - m_baseX;
+                offX = (x() + offsetX)/m_scale - m_baseX;
                 offW = (width() - offsetX)/m_scale - m_baseWidth;
             }
             if(height() - offsetY > m_minHeight*m_scale) {
-                offY = (point.y() + m_pan.y())/m_scale - m_baseY;
+                offY = point.y()/m_scale - m_baseY;
                 offH = (height() - offsetY)/m_scale - m_baseHeight;
             }
             else {
                 offsetY = height() - m_minHeight*m_scale;
-                offY = (y() + offsetY + m_pan.y())/m_scale - m_baseY;
+                offY = (y() + offsetY)/m_scale - m_baseY;
                 offH = (height() - offsetY)/m_scale - m_baseHeight;
             }
             scene->resizedFrame(this, offX, offY, offW, offH);
@@ -277,24 +284,24 @@ void Frame::mouseMoveEvent(QMouseEvent *event) {
             if(offsetX < m_minWidth*m_scale) offsetX = m_minWidth*m_scale;
             offW = offsetX/m_scale - m_baseWidth;
             if(height() - offsetY > m_minHeight*m_scale) {
-                offY = (point.y() + m_pan.y())/m_scale - m_baseY;
+                offY = point.y()/m_scale - m_baseY;
                 offH = (height() - offsetY)/m_scale - m_baseHeight;
             }
             else {
                 offsetY = height() - m_minHeight*m_scale;
-                offY = (y() + offsetY + m_pan.y())/m_scale - m_baseY;
+                offY = (y() + offsetY)/m_scale - m_baseY;
                 offH = (height() - offsetY)/m_scale - m_baseHeight;
             }
             scene->resizedFrame(this, offX, offY, offW, offH);
             break;
         case BOTTOMLEFT:
             if(width() - offsetX > m_minWidth*m_scale) {
-                offX = (point.x() + m_pan.x())/m_scale - m_baseX;
+                offX = point.x()/m_scale - m_baseX;
                 offW = (width() - offsetX)/m_scale - m_baseWidth;
             }
             else {
                 offsetX = width() - m_minWidth*m_scale;
-                offX = (x() + offsetX + m_pan.x())/m_scale - m_baseX;
+                offX = (x() + offsetX)/m_scale - m_baseX;
                 offW = (width() - offsetX)/m_scale - m_baseWidth;
             }
             if(offsetY < m_minHeight*m_scale) offsetY = m_minHeight*m_scale;
@@ -310,31 +317,19 @@ void Frame::mouseMoveEvent(QMouseEvent *event) {
             break;
         case NOT:
             m_moved = true;
-            Scene *scene = qobject_cast<Scene*>(parentItem());
+            Scene *scene = Scene::sceneOf(this);
             setX(point.x() - lastX);
-            float offsetBaseX = (x() + m_pan.x())/m_scale - m_baseX;
+            float offsetBaseX = x()/m_scale - m_baseX;
             setY(point.y() - lastY);
-            float offsetBaseY = (y() + m_pan.y())/m_scale - m_baseY;
-            for(int i = 0; i < scene->countSelected(); ++i) {
-                QQuickItem *item = scene->atSelected(i);
-                if(qobject_cast<Node*>(item)) {
-                    Node *n = qobject_cast<Node*>(item);
-                    n->setBaseX(n->baseX() + offsetBaseX);
-                    n->setBaseY(n->baseY() + offsetBaseY);
-                }
-                else if(qobject_cast<Frame*>(item)) {
-                    Frame *f = qobject_cast<Frame*>(item);
-                    f->setBaseX(f->baseX() + offsetBaseX);
-                    f->setBaseY(f->baseY() + offsetBaseY);
-                }
-            }
+            float offsetBaseY = y()/m_scale - m_baseY;
+            scene->moveItems(scene->selectedList(), QVector2D(offsetBaseX, offsetBaseY));
         }
     }
 }
 
 void Frame::mouseReleaseEvent(QMouseEvent *event) {
     if(event->button() == Qt::LeftButton && event->modifiers() == Qt::NoModifier) {
-        Scene *scene = qobject_cast<Scene*>(parentItem());
+        Scene *scene = Scene::sceneOf(this);
         if(m_selected && !m_moved) {            
             if(scene->countSelected() == 1) return;
             QList<QQuickItem*> selectedList = scene->selectedList();
@@ -432,6 +427,17 @@ void Frame::removeItem(QQuickItem *item) {
     if(m_content.size() > 0) resizeByContent();
 }
 
+void Frame::removeItems(QList<QQuickItem *> items) {
+    for(QQuickItem *item: items) {
+        if(!m_content.removeOne(item)) continue;
+        if(qobject_cast<Node*>(item)) {
+            Node *node = qobject_cast<Node*>(item);
+            node->setAttachedFrame(nullptr);
+        }
+    }
+    if(m_content.size() > 0) resizeByContent();
+}
+
 bool Frame::selected() {
     return m_selected;
 }
@@ -483,7 +489,7 @@ void Frame::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
     }
     if(json.contains("nodes") && json["nodes"].isArray()) {
         m_content.clear();
-        Scene *scene = qobject_cast<Scene*>(parentItem());
+        Scene *scene = Scene::sceneOf(this);
         QJsonArray nodes = json["nodes"].toArray();
         for(int i = 0; i < nodes.size(); ++i) {
             QJsonObject nodesObject = nodes[i].toObject();
@@ -501,6 +507,6 @@ void Frame::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
 }
 
 void Frame::titleChanged(QString newTitle, QString oldTitle) {
-    Scene *scene = qobject_cast<Scene*>(parentItem());
+    Scene *scene = Scene::sceneOf(this);
     scene->changedTitle(this, newTitle, oldTitle);
 }
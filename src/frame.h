@@ -22,7 +22,7 @@
 #ifndef FRAME_H
 #define FRAME_H
 #include <QQuickItem>
-#include <QQuickView>
+#include "components.h"
 #include "node.h"
 
 enum resize {LEFT, RIGHT, TOP, BOTTOM, TOPLEFT, TOPRIGHT, BOTTOMLEFT, BOTTOMRIGHT, NOT};
@@ -37,14 +37,13 @@ public:
     void setBaseX(float x);
     float baseY();
     void setBaseY(float y);
+    void setBasePosition(QVector2D pos);
     float baseWidth();
     void setBaseWidth(float width);
     float baseHeight();
     void setBaseHeight(float height);
     QString title();
     void setTitle(QString title);
-    QVector2D pan();
-    void setPan(QVector2D pan);
     void setScaleView(float scale);
     void resizeByContent();
     void mousePressEvent(QMouseEvent *event);
@@ -56,6 +55,7 @@ public:
     void hoverLeaveEvent(QHoverEvent *event);
     void addNodes(QList<QQuickItem*> nodes);
     void removeItem(QQuickItem *item);
+    void removeItems(QList<QQuickItem*> items);
     bool selected();
     void setSelected(bool sel);
     QList<QQuickItem*> contentList() const;
@@ -66,7 +66,6 @@ signals:
 public slots:
     void titleChanged(QString newTitle, QString oldTitle);
 private:
-    QQuickView *m_view = nullptr;
     QQuickItem *m_grFrame = nullptr;
     QList<QQuickItem*> m_content;
     float m_baseX;
@@ -74,7 +73,6 @@ private:
     float m_baseWidth = 200;
     float m_baseHeight = 100;
     float m_scale = 1.0f;
-    QVector2D m_pan = QVector2D(0, 0);
     float lastX = 0;
     float lastY = 0;
     float m_oldX = 0;
@@ -0,0 +1,73 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "hash.h"
+#include <QFile>
+#include <QRegularExpression>
+
+uint32_t pcgHash(uint32_t v) {
+    uint32_t state = v*747796405u + 2891336453u;
+    uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state)*277803737u;
+    return (word >> 22u) ^ word;
+}
+
+uint32_t hashCell(int x, int y, int seed) {
+    return pcgHash(static_cast<uint32_t>(x) + pcgHash(static_cast<uint32_t>(y) + pcgHash(static_cast<uint32_t>(seed))));
+}
+
+float hashToFloat(uint32_t h) {
+    return static_cast<float>(h >> 8u)*(1.0f/16777216.0f);
+}
+
+QVector2D hash22(int x, int y, int seed) {
+    uint32_t h = hashCell(x, y, seed);
+    return QVector2D(hashToFloat(h), hashToFloat(pcgHash(h)));
+}
+
+QVector4D hash42(int x, int y, int seed) {
+    uint32_t h1 = hashCell(x, y, seed);
+    uint32_t h2 = pcgHash(h1);
+    uint32_t h3 = pcgHash(h2);
+    uint32_t h4 = pcgHash(h3);
+    return QVector4D(hashToFloat(h1), hashToFloat(h2), hashToFloat(h3), hashToFloat(h4));
+}
+
+QByteArray shaderWithIncludes(const QString &fileName) {
+    // shared glsl such as hash.glsl or uvchain.glsl is pasted in place of its #include line
+    QFile shaderFile(fileName);
+    if(!shaderFile.open(QIODevice::ReadOnly)) {
+        qWarning("Couldn`t open shader file.");
+        return QByteArray();
+    }
+    QByteArray source = shaderFile.readAll();
+    QRegularExpression include("#include \"([^\"]+)\"");
+    QRegularExpressionMatch match = include.match(QString::fromUtf8(source));
+    while(match.hasMatch()) {
+        QFile includeFile(":/shaders/" + match.captured(1));
+        if(!includeFile.open(QIODevice::ReadOnly)) {
+            qWarning("Couldn`t open shader file.");
+            return QByteArray();
+        }
+        source.replace(match.captured(0).toUtf8(), includeFile.readAll());
+        match = include.match(QString::fromUtf8(source));
+    }
+    return source;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HASH_H
+#define HASH_H
+#include <QByteArray>
+#include <QString>
+#include <QVector2D>
+#include <QVector4D>
+#include <cstdint>
+
+uint32_t pcgHash(uint32_t v);
+uint32_t hashCell(int x, int y, int seed);
+float hashToFloat(uint32_t h);
+QVector2D hash22(int x, int y, int seed);
+QVector4D hash42(int x, int y, int seed);
+QByteArray shaderWithIncludes(const QString &fileName);
+
+#endif // HASH_H
@@ -0,0 +1,106 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "heightnode.h"
+
+HeightNode::HeightNode(QQuickItem *parent, QVector2D resolution): Node(parent, resolution)
+{
+    createSockets(1, 0);
+    setTitle("Height");
+    m_socketsInput[0]->setTip("Height");
+    preview = new OneChanelObject(grNode, m_resolution);
+    float s = scaleView();
+    preview->setTransformOrigin(TopLeft);
+    preview->setWidth(174);
+    preview->setHeight(174);
+    preview->setX(3*s);
+    preview->setY(30*s);
+    preview->setScale(s);
+    preview->setValue(0.0f);
+    connect(this, &Node::changeScaleView, this, &HeightNode::updateScale);
+    connect(preview, &OneChanelObject::updatePreview, this, &HeightNode::updatePreview);
+    connect(preview, &OneChanelObject::updateValue, this, &HeightNode::heightChanged);
+    connect(this, &Node::changeResolution, preview, &OneChanelObject::setResolution);
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/HeightProperty.qml"));
+}
+
+HeightNode::~HeightNode() {
+    delete preview;
+}
+
+void HeightNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startHeightScale", m_heightScale);
+    connect(propertiesPanel, SIGNAL(heightScaleChanged(qreal)), this, SLOT(updateHeightScale(qreal)));
+}
+
+void HeightNode::operation() {
+    if(m_socketsInput[0]->countEdge() > 0) {
+        preview->setValue(m_socketsInput[0]->value());
+        preview->useTex = true;
+    }
+    else {
+        preview->setValue(0.0f);
+        preview->useTex = false;
+    }
+    preview->selectedItem = selected();
+    preview->update();
+}
+
+unsigned int &HeightNode::getPreviewTexture() {
+    return preview->texture();
+}
+
+void HeightNode::saveTexture(QString fileName) {
+    preview->saveTexture(fileName);
+}
+
+void HeightNode::serialize(QJsonObject &json) const {
+    Node::serialize(json);
+    json["type"] = 23;
+    json["heightScale"] = m_heightScale;
+}
+
+void HeightNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash) {
+    Node::deserialize(json, hash);
+    if(json.contains("heightScale")) {
+        updateHeightScale(json["heightScale"].toVariant().toFloat());
+    }
+}
+
+float HeightNode::heightScale() {
+    return m_heightScale;
+}
+
+void HeightNode::updateHeightScale(qreal scale) {
+    m_heightScale = scale;
+    heightScaleChanged(m_heightScale);
+    dataChanged();
+}
+
+void HeightNode::updateScale(float scale) {
+    preview->setX(3*scale);
+    preview->setY(30*scale);
+    preview->setScale(scale);
+}
+
+void HeightNode::saveHeight(QString dir) {
+    preview->saveTexture(dir.append("/height.png"));
+}
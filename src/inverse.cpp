@@ -20,9 +20,9 @@
  */
 
 #include "inverse.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 
-InverseObject::InverseObject(QQuickItem *parent, QVector2D resolution):QQuickFramebufferObject (parent),
+InverseObject::InverseObject(QQuickItem *parent, QVector2D resolution):ThumbnailObject(parent),
     m_resolution(resolution)
 {
 
@@ -69,18 +69,9 @@ void InverseObject::setResolution(QVector2D res) {
 
 InverseRenderer::InverseRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    inverseShader = new QOpenGLShaderProgram();
-    inverseShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    inverseShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/inverse.frag");
-    inverseShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    inverseShader = createShaderProgram(PROGRAM_INVERSE);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     inverseShader->bind();
     inverseShader->setUniformValue(inverseShader->uniformLocation("sourceTexture"), 0);
     inverseShader->release();
@@ -127,14 +118,8 @@ InverseRenderer::~InverseRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *InverseRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void InverseRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     InverseObject *inverseItem = static_cast<InverseObject*>(item);
     if(inverseItem->resUpdated) {
         inverseItem->resUpdated = false;
@@ -156,7 +141,7 @@ void InverseRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void InverseRenderer::render() {
+void InverseRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
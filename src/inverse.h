@@ -22,12 +22,12 @@
 #ifndef INVERSE_H
 #define INVERSE_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class InverseObject: public QQuickFramebufferObject
+class InverseObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -54,13 +54,12 @@ private:
     unsigned int m_sourceTexture = 0;
 };
 
-class InverseRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class InverseRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     InverseRenderer(QVector2D res);
     ~InverseRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void inverte();
     void updateTexResolution();
@@ -27,16 +27,20 @@
 #include "scene.h"
 #include "node.h"
 #include "mainwindow.h"
+#include "components.h"
+#include "shaderwarmup.h"
 
 int main(int argc, char *argv[])
 {
     QCoreApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
-
-    QApplication app(argc, argv);
+    QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
     QSurfaceFormat format;
     format.setSamples(16);
     QSurfaceFormat::setDefaultFormat(format);
 
+    QApplication app(argc, argv);
+    ShaderWarmup::instance()->start();
+
     qmlRegisterType<BackgroundObject>("backgroundobject", 1, 0, "BackgroundObject");
     qmlRegisterType<PreviewObject>("preview", 1, 0, "PreviewObject");
     qmlRegisterType<Preview3DObject>("preview3d", 1, 0, "Preview3DObject");
@@ -47,6 +51,7 @@ int main(int argc, char *argv[])
     qRegisterMetaType<QList<Node*>>("QList<Node*>");
 
     QQmlApplicationEngine engine;
+    setComponentsEngine(&engine);
     engine.load(QUrl(QStringLiteral("qrc:/main.qml")));
     if (engine.rootObjects().isEmpty())
         return -1;
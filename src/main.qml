@@ -56,7 +56,27 @@ MainWindow {
                 width: 100
                 height: 30
                 leftPadding: 15
+                indicator: Item {
+                            implicitWidth: 30
+                            implicitHeight: 30
+                            Rectangle {
+                                width: 12
+                                height: 12
+                                anchors.centerIn: parent
+                                visible: menuFile.checkable
+                                color: "transparent"
+                                border.color: "#A2A2A2"
+                                Rectangle {
+                                    width: 4
+                                    height: 4
+                                    anchors.centerIn: parent
+                                    visible: menuFile.checked
+                                    color: "#A2A2A2"
+                                }
+                            }
+                        }
                 contentItem: Text{
+                  leftPadding: menuFile.checkable ? menuFile.indicator.width - menuFile.leftPadding : 0
                   text: menuFile.text
                   color: "#A2A2A2"
                 }
@@ -99,6 +119,13 @@ MainWindow {
                     mainWindow.exportTextures()
                 }
             }
+            Action {
+                text: "Compress"
+                checkable: true
+                onTriggered: {
+                    mainWindow.setCompressOutputs(checked)
+                }
+            }
 
         }
         Menu { title: qsTr("Edit")
@@ -112,6 +139,25 @@ MainWindow {
                 width: 100
                 height: 30
                 leftPadding: 15
+                indicator: Item {
+                            implicitWidth: 30
+                            implicitHeight: 30
+                            Rectangle {
+                                width: 12
+                                height: 12
+                                anchors.centerIn: parent
+                                visible: menuEdit.checkable
+                                color: "transparent"
+                                border.color: "#A2A2A2"
+                                Rectangle {
+                                    width: 4
+                                    height: 4
+                                    anchors.centerIn: parent
+                                    visible: menuEdit.checked
+                                    color: "#A2A2A2"
+                                }
+                            }
+                        }
                 arrow: Canvas {
                             x: parent.width - width
                             implicitWidth: 30
@@ -128,6 +174,7 @@ MainWindow {
                             }
                         }
                 contentItem: Text{
+                  leftPadding: menuEdit.checkable ? menuEdit.indicator.width - menuEdit.leftPadding : 0
                   text: menuEdit.text
                   color: "#A2A2A2"
                 }
@@ -230,6 +277,14 @@ MainWindow {
                     }
                 }
             }
+            Action {
+                text: "Undo cache"
+                checkable: true
+                checked: true
+                onTriggered: {
+                    mainWindow.setRetainOutputs(checked)
+                }
+            }
         }
 
         delegate: MenuBarItem {
@@ -335,6 +390,12 @@ MainWindow {
                     mainWindow.createNode(addNode.x, addNode.y, 12)
                 }
             }
+            Action {
+                text: "Height"
+                onTriggered: {
+                    mainWindow.createNode(addNode.x, addNode.y, 23)
+                }
+            }
             background: Rectangle {
                             implicitWidth: 100
                             implicitHeight: 30
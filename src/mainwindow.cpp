@@ -23,6 +23,7 @@
 #include <iostream>
 #include <QtWidgets/QFileDialog>
 #include <QApplication>
+#include <QtWidgets/QMessageBox>
 
 MainWindow::MainWindow(QWindow *parent):QQuickWindow (parent)
 {
@@ -41,7 +42,7 @@ MainWindow::~MainWindow() {
 }
 
 void MainWindow::createNode(float x, float y, int nodeType) {
-    if(activeTab) {
+    if(sceneEditable()) {
         Node *n = nullptr;
         switch (nodeType) {
             case 0:
@@ -114,6 +115,10 @@ void MainWindow::createNode(float x, float y, int nodeType) {
             case 22:
                 n = new ThresholdNode(activeTab->scene(), activeTab->scene()->resolution());
                 break;
+            case 23:
+                if(activeTab->scene()->heightConnected()) break;
+                n = new HeightNode(activeTab->scene(), activeTab->scene()->resolution());
+                break;
             default:
                 break;
         }
@@ -123,13 +128,12 @@ void MainWindow::createNode(float x, float y, int nodeType) {
         float scale = activeTab->scene()->background()->viewScale();
         n->setBaseX((x + pan.x())/scale);
         n->setBaseY((y + pan.y())/scale);
-        n->setPan(pan);
         activeTab->scene()->addedNode(n);
     }
 }
 
 void MainWindow::createFrame(float x, float y) {
-    if(activeTab) {
+    if(sceneEditable()) {
         Frame *frame = new Frame(activeTab->scene());
         activeTab->scene()->addFrame(frame);
         QVector2D pan = activeTab->scene()->background()->viewPan();
@@ -147,6 +151,9 @@ void MainWindow::newDocument() {
     connect(tab, &Tab::changeActiveTab, this, &MainWindow::setActiveTab);
     connect(tab, &Tab::closedTab, this, &MainWindow::closeTab);
     connect(tab->scene(), &Scene::activeNodeChanged, this, &MainWindow::activeNodeChanged);
+    connect(tab->scene(), &Scene::saveFinished, this, &MainWindow::sceneSaved);
+    tab->scene()->setRetainOutputs(m_retainOutputs);
+    tab->scene()->setCompressOutputs(m_compressOutputs);
     setActiveTab(tab);
     tabs.append(tab);
     emit addTab(tab);
@@ -159,7 +166,7 @@ void MainWindow::copy() {
 }
 
 void MainWindow::paste() {
-    if(activeTab) {
+    if(sceneEditable()) {
         float sceneX = QCursor::pos().x() - x();
         float sceneY = QCursor::pos().y() - y();
         m_clipboard->paste(sceneX, sceneY, activeTab->scene());
@@ -167,29 +174,29 @@ void MainWindow::paste() {
 }
 
 void MainWindow::cut() {
-    if(activeTab) {
+    if(sceneEditable()) {
       m_clipboard->cut(activeTab->scene());
     }
 }
 
 void MainWindow::deleteItems() {
-    if(activeTab) {
+    if(sceneEditable()) {
         activeTab->scene()->deleteItems();
     }
 }
 
 void MainWindow::saveScene() {
-    if(activeTab) {
+    if(sceneEditable()) {
         QString fileName = activeTab->scene()->fileName();
         activeTab->scene()->saveScene(fileName);
     }
 }
 
 void MainWindow::saveSceneAs() {
-    if(activeTab) {
+    if(sceneEditable()) {
         QString fileName = QFileDialog::getSaveFileName(nullptr,
                 tr("Save Node Scene"), "",
-                tr("Node Scene (*.sne);"));
+                tr("Node Scene (*.sne);;Node Scene with Outputs (*.snb)"));
         if(fileName.isEmpty()) return;
         activeTab->scene()->saveScene(fileName);
     }
@@ -198,7 +205,7 @@ void MainWindow::saveSceneAs() {
 void MainWindow::loadScene() {
     QString fileName = QFileDialog::getOpenFileName(nullptr,
             tr("Open Node Scene"), "",
-            tr("Node Scene (*.sne);"));
+            tr("Node Scene (*.sne *.snb)"));
     if(fileName.isEmpty()) return;
     for(auto tab: tabs) {
         if(tab->scene()->fileName() == fileName) {
@@ -238,7 +245,7 @@ void MainWindow::saveCurrentTexture() {
 }
 
 void MainWindow::changeResolution(QVector2D res) {
-    if(activeTab) {
+    if(sceneEditable()) {
         activeTab->scene()->setResolution(res);
     }
 }
@@ -256,13 +263,13 @@ void MainWindow::changeTilePreview3D(int id) {
 }
 
 void MainWindow::undo() {
-    if(activeTab) {
+    if(sceneEditable()) {
         activeTab->scene()->undo();
     }
 }
 
 void MainWindow::redo() {
-    if(activeTab) {
+    if(sceneEditable()) {
         activeTab->scene()->redo();
     }
 }
@@ -286,6 +293,20 @@ void MainWindow::pin(bool pinned) {
     }
 }
 
+void MainWindow::setRetainOutputs(bool retain) {
+    m_retainOutputs = retain;
+    for(auto tab: tabs) {
+        tab->scene()->setRetainOutputs(retain);
+    }
+}
+
+void MainWindow::setCompressOutputs(bool compress) {
+    m_compressOutputs = compress;
+    for(auto tab: tabs) {
+        tab->scene()->setCompressOutputs(compress);
+    }
+}
+
 void MainWindow::keyPressEvent(QKeyEvent *event) {
     if(event->key() == Qt::Key_C && event->modifiers() == Qt::ControlModifier) {
         if(activeFocusItem() && activeFocusItem() != contentItem()) {
@@ -333,13 +354,13 @@ void MainWindow::keyPressEvent(QKeyEvent *event) {
     }
 }
 void MainWindow::duplicate() {
-    if(activeTab) {
+    if(sceneEditable()) {
       m_clipboard->duplicate(activeTab->scene());
     }
 }
 
 void MainWindow::removeFromFrame() {
-    if(activeTab) {
+    if(sceneEditable()) {
         activeTab->scene()->removeFromFrame();
     }
 }
@@ -389,6 +410,10 @@ void MainWindow::closeTab(Tab *tab) {
     tab->deleteLater();
 }
 
+bool MainWindow::sceneEditable() const {
+    return activeTab && !activeTab->scene()->loading();
+}
+
 Node *MainWindow::pinnedNode() {
     return m_pinnedNode;
 }
@@ -398,6 +423,7 @@ Node *MainWindow::activeNode() {
 }
 
 void MainWindow::activeNodeChanged() {
+    Node *oldNode = m_activeNode;
     QQuickItem *oldPanel = m_activeNode ? m_activeNode->getPropertyPanel() : nullptr;
     if(!m_pinnedNode && m_activeNode) {
         disconnect(m_activeNode, &Node::updatePreview, this, &MainWindow::previewUpdate);
@@ -405,6 +431,7 @@ void MainWindow::activeNodeChanged() {
     m_activeNode = activeTab->scene()->activeNode();
     QQuickItem *newPanel = m_activeNode ? m_activeNode->getPropertyPanel() : nullptr;
     propertiesPanelChanged(oldPanel, newPanel);
+    if(oldNode && oldNode != m_activeNode) oldNode->releasePropertyPanel();
     if(!m_pinnedNode && m_activeNode) {
         connect(m_activeNode, &Node::updatePreview, this, &MainWindow::previewUpdate);
         previewUpdate(m_activeNode->getPreviewTexture());
@@ -413,3 +440,9 @@ void MainWindow::activeNodeChanged() {
         previewUpdate(0);
     }
 }
+
+void MainWindow::sceneSaved(QString fileName, bool saved) {
+    // binary saves finish after the outputs are captured, failures are reported from here
+    if(saved) return;
+    QMessageBox::warning(nullptr, tr("Save Node Scene"), tr("Couldn't save %1.").arg(fileName));
+}
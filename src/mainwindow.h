@@ -46,6 +46,7 @@
 #include "mirrornode.h"
 #include "brightnesscontrastnode.h"
 #include "thresholdnode.h"
+#include "heightnode.h"
 #include "frame.h"
 
 class MainWindow: public QQuickWindow
@@ -72,6 +73,8 @@ public:
     Q_INVOKABLE void undo();
     Q_INVOKABLE void redo();
     Q_INVOKABLE void pin(bool pinned);
+    Q_INVOKABLE void setRetainOutputs(bool retain);
+    Q_INVOKABLE void setCompressOutputs(bool compress);
     MainWindow(QWindow *parent = nullptr);
     ~MainWindow();
     void keyPressEvent(QKeyEvent *event);
@@ -82,6 +85,7 @@ public:
     Node *pinnedNode();
     Node *activeNode();
     void activeNodeChanged();
+    void sceneSaved(QString fileName, bool saved);
 
 signals:
     void addTab(Tab *tab);
@@ -91,11 +95,14 @@ signals:
     void previewUpdate(unsigned int previewData);
     void resolutionChanged(QVector2D res);
 private:
+    bool sceneEditable() const;
     Tab *activeTab = nullptr;
     Node *m_activeNode = nullptr;
     Node *m_pinnedNode = nullptr;
     QList<Tab*> tabs;
     Clipboard *m_clipboard = nullptr;
+    bool m_retainOutputs = true;
+    bool m_compressOutputs = false;
 };
 
 #endif // MAINWINDOW_H
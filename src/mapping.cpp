@@ -20,10 +20,10 @@
  */
 
 #include "mapping.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 
 MappingObject::MappingObject(QQuickItem *parent, QVector2D resolution, float inputMin, float inputMax,
-                             float outputMin, float outputMax): QQuickFramebufferObject (parent),
+                             float outputMin, float outputMax): ThumbnailObject(parent),
     m_resolution(resolution), m_inputMin(inputMin), m_inputMax(inputMax), m_outputMin(outputMin),
     m_outputMax(outputMax)
 {
@@ -127,18 +127,9 @@ MappingRenderer::~MappingRenderer() {
 
 MappingRenderer::MappingRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    mappingShader = new QOpenGLShaderProgram();
-    mappingShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    mappingShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/mapping.frag");
-    mappingShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    mappingShader = createShaderProgram(PROGRAM_MAPPING);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     mappingShader->bind();
     mappingShader->setUniformValue(mappingShader->uniformLocation("sourceTexture"), 0);
     mappingShader->setUniformValue(mappingShader->uniformLocation("maskTexture"), 1);
@@ -177,14 +168,8 @@ MappingRenderer::MappingRenderer(QVector2D res): m_resolution(res) {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-QOpenGLFramebufferObject *MappingRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void MappingRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     MappingObject *mappingItem = static_cast<MappingObject*>(item);
     if(mappingItem->resUpdated) {
         mappingItem->resUpdated = false;
@@ -214,7 +199,7 @@ void MappingRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void MappingRenderer::render() {
+void MappingRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
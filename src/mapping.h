@@ -22,12 +22,12 @@
 #ifndef MAPPING_H
 #define MAPPING_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class MappingObject: public QQuickFramebufferObject
+class MappingObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -69,13 +69,12 @@ private:
     float m_outputMax = 1.0f;
 };
 
-class MappingRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class MappingRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     MappingRenderer(QVector2D res);
     ~MappingRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void map();
     void updateTexResolution();
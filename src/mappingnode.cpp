@@ -42,18 +42,7 @@ MappingNode::MappingNode(QQuickItem *parent, QVector2D resolution, float inputMi
     connect(this, &MappingNode::inputMaxChanged, preview, &MappingObject::setInputMax);
     connect(this, &MappingNode::outputMinChanged, preview, &MappingObject::setOutputMin);
     connect(this, &MappingNode::outputMaxChanged, preview, &MappingObject::setOutputMax);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/MappingProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    connect(propertiesPanel, SIGNAL(inputMinChanged(qreal)), this, SLOT(updateInputMin(qreal)));
-    connect(propertiesPanel, SIGNAL(inputMaxChanged(qreal)), this, SLOT(updateInputMax(qreal)));
-    connect(propertiesPanel, SIGNAL(outputMinChanged(qreal)), this, SLOT(updateOutputMin(qreal)));
-    connect(propertiesPanel, SIGNAL(outputMaxChanged(qreal)), this, SLOT(updateOutputMax(qreal)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-    propertiesPanel->setProperty("startInputMin", m_inputMin);
-    propertiesPanel->setProperty("startInputMax", m_inputMax);
-    propertiesPanel->setProperty("startOutputMin", m_outputMin);
-    propertiesPanel->setProperty("startOutputMax", m_outputMax);
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/MappingProperty.qml"));
     createSockets(2, 1);
     setTitle("Map Range");
     m_socketsInput[0]->setTip("Texture");
@@ -64,6 +53,17 @@ MappingNode::~MappingNode() {
     delete preview;
 }
 
+void MappingNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startInputMin", m_inputMin);
+    propertiesPanel->setProperty("startInputMax", m_inputMax);
+    propertiesPanel->setProperty("startOutputMin", m_outputMin);
+    propertiesPanel->setProperty("startOutputMax", m_outputMax);
+    connect(propertiesPanel, SIGNAL(inputMinChanged(qreal)), this, SLOT(updateInputMin(qreal)));
+    connect(propertiesPanel, SIGNAL(inputMaxChanged(qreal)), this, SLOT(updateInputMax(qreal)));
+    connect(propertiesPanel, SIGNAL(outputMinChanged(qreal)), this, SLOT(updateOutputMin(qreal)));
+    connect(propertiesPanel, SIGNAL(outputMaxChanged(qreal)), this, SLOT(updateOutputMax(qreal)));
+}
+
 void MappingNode::operation() {
     preview->selectedItem = selected();
     preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
@@ -92,19 +92,15 @@ void MappingNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &ha
     Node::deserialize(json, hash);
     if(json.contains("inputMin")) {
         updateInputMin(json["inputMin"].toVariant().toReal());
-        propertiesPanel->setProperty("startInputMin", m_inputMin);
     }
     if(json.contains("inputMax")) {
         updateInputMax(json["inputMax"].toVariant().toReal());
-        propertiesPanel->setProperty("startInputMax", m_inputMax);
     }
     if(json.contains("outputMin")) {
         updateOutputMin(json["outputMin"].toVariant().toReal());
-        propertiesPanel->setProperty("startOutputMin", m_outputMin);
     }
     if(json.contains("outputMax")) {
         updateOutputMax(json["outputMax"].toVariant().toReal());
-        propertiesPanel->setProperty("startOutputMax", m_outputMax);
     }
 }
 
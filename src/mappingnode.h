@@ -57,6 +57,8 @@ public slots:
     void updateInputMax(qreal value);
     void updateOutputMin(qreal value);
     void updateOutputMax(qreal value);
+protected:
+    void setupPropertyPanel();
 private:
     MappingObject *preview;
     float m_inputMin = 0.0f;
@@ -38,17 +38,18 @@ MetalNode::MetalNode(QQuickItem *parent, QVector2D resolution): Node(parent, res
     connect(this, &Node::changeScaleView, this, &MetalNode::updateScale);
     connect(preview, &OneChanelObject::updateValue, this, &MetalNode::metalChanged);
     connect(this, &Node::changeResolution, preview, &OneChanelObject::setResolution);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/MetalProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    connect(propertiesPanel, SIGNAL(metalChanged(qreal)), this, SLOT(updateMetal(qreal)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/MetalProperty.qml"));
 }
 
 MetalNode::~MetalNode() {
     delete preview;
 }
 
+void MetalNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startMetal", m_metal);
+    connect(propertiesPanel, SIGNAL(metalChanged(qreal)), this, SLOT(updateMetal(qreal)));
+}
+
 void MetalNode::operation() {
     if(m_socketsInput[0]->countEdge() > 0) {
         preview->setValue(m_socketsInput[0]->value());
@@ -80,14 +81,13 @@ void MetalNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash
     Node::deserialize(json, hash);
     if(json.contains("metal")) {
         updateMetal(json["metal"].toVariant().toFloat());
-        propertiesPanel->setProperty("startMetal", m_metal);
     }    
 }
 
 void MetalNode::updateMetal(qreal metal) {
     m_metal = metal;
     if(m_socketsInput[0]->countEdge() == 0) {
-        operation();
+        requestOperation();
     }
     dataChanged();
 }
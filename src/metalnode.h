@@ -42,6 +42,8 @@ public slots:
     void saveMetal(QString dir);
 signals:
     void metalChanged(QVariant metal, bool useTexture);
+protected:
+    void setupPropertyPanel();
 private:
     OneChanelObject *preview;
     float m_metal = 0.0f;
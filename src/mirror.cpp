@@ -20,10 +20,10 @@
  */
 
 #include "mirror.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 
 MirrorObject::MirrorObject(QQuickItem *parent, QVector2D resolution, int dir):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_direction(dir)
+    ThumbnailObject(parent), m_resolution(resolution), m_direction(dir)
 {
 
 }
@@ -77,6 +77,16 @@ void MirrorObject::setDirection(int dir) {
     update();
 }
 
+QVector<UVStage> MirrorObject::uvStages() {
+    return m_uvStages;
+}
+
+void MirrorObject::setUVStages(QVector<UVStage> stages) {
+    m_uvStages = stages;
+    mirroredTex = true;
+    update();
+}
+
 QVector2D MirrorObject::resolution() {
     return m_resolution;
 }
@@ -89,18 +99,9 @@ void MirrorObject::setResolution(QVector2D res) {
 
 MirrorRenderer::MirrorRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    mirrorShader = new QOpenGLShaderProgram();
-    mirrorShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    mirrorShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/mirror.frag");
-    mirrorShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    mirrorShader = createShaderProgram(PROGRAM_MIRROR);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     mirrorShader->bind();
     mirrorShader->setUniformValue(mirrorShader->uniformLocation("sourceTexture"), 0);
     mirrorShader->setUniformValue(mirrorShader->uniformLocation("maskTexture"), 1);
@@ -144,14 +145,8 @@ MirrorRenderer::~MirrorRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *MirrorRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void MirrorRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     MirrorObject *mirrorItem = static_cast<MirrorObject*>(item);
     if(mirrorItem->resUpdated) {
         mirrorItem->resUpdated = false;
@@ -166,6 +161,7 @@ void MirrorRenderer::synchronize(QQuickFramebufferObject *item) {
             mirrorShader->bind();
             mirrorShader->setUniformValue(mirrorShader->uniformLocation("dir"), mirrorItem->direction());
             mirrorShader->setUniformValue(mirrorShader->uniformLocation("useMask"), maskTexture);
+            setUVStagesUniforms(mirrorShader, mirrorItem->uvStages());
             mirrorShader->release();
             mirror();
             mirrorItem->setTexture(m_mirrorTexture);
@@ -178,7 +174,7 @@ void MirrorRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void MirrorRenderer::render() {
+void MirrorRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
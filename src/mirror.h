@@ -22,12 +22,13 @@
 #ifndef MIRROR_H
 #define MIRROR_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
+#include "uvchain.h"
 #include "FreeImage.h"
 
-class MirrorObject: public QQuickFramebufferObject
+class MirrorObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -42,6 +43,8 @@ public:
     void saveTexture(QString fileName);
     int direction();
     void setDirection(int dir);
+    QVector<UVStage> uvStages();
+    void setUVStages(QVector<UVStage> stages);
     QVector2D resolution();
     void setResolution(QVector2D res);
     bool mirroredTex = false;
@@ -57,16 +60,16 @@ private:
     unsigned int m_sourceTexture = 0;
     unsigned int m_texture = 0;
     unsigned int m_maskTexture = 0;
+    QVector<UVStage> m_uvStages;
     int m_direction = 0;
 };
 
-class MirrorRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class MirrorRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     MirrorRenderer(QVector2D res);
     ~MirrorRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void mirror();
     void updateTexResolution();
@@ -38,12 +38,7 @@ MirrorNode::MirrorNode(QQuickItem *parent, QVector2D resolution, int dir): Node(
     connect(preview, &MirrorObject::textureChanged, this, &MirrorNode::setOutput);
     connect(this, &Node::changeResolution, preview, &MirrorObject::setResolution);
     connect(this, &MirrorNode::directionChanged, preview, &MirrorObject::setDirection);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/MirrorProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    propertiesPanel->setProperty("startDirection", m_direction);
-    connect(propertiesPanel, SIGNAL(directionChanged(int)), this, SLOT(updateDirection(int)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/MirrorProperty.qml"));
     createSockets(2, 1);
     setTitle("Mirror");
     m_socketsInput[0]->setTip("Texture");
@@ -54,8 +49,16 @@ MirrorNode::~MirrorNode() {
     delete preview;
 }
 
+void MirrorNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startDirection", m_direction);
+    connect(propertiesPanel, SIGNAL(directionChanged(int)), this, SLOT(updateDirection(int)));
+}
+
 void MirrorNode::operation() {
-    preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
+    QVector<UVStage> stages;
+    unsigned int source = collectUVChain(m_socketsInput[0], stages);
+    preview->setUVStages(stages);
+    preview->setSourceTexture(source);
     preview->setMaskTexture(m_socketsInput[1]->value().toUInt());
     if(m_socketsInput[0]->countEdge() == 0) m_socketOutput[0]->setValue(0);
 }
@@ -68,6 +71,14 @@ void MirrorNode::saveTexture(QString fileName) {
     preview->saveTexture(fileName);
 }
 
+bool MirrorNode::uvStage(UVStage &stage, Socket *&source) {
+    if(m_socketsInput[1]->countEdge() > 0) return false;
+    stage.mode = UV_MIRROR;
+    stage.dir = m_direction;
+    source = m_socketsInput[0];
+    return true;
+}
+
 void MirrorNode::serialize(QJsonObject &json) const {
     Node::serialize(json);
     json["type"] = 5;
@@ -78,7 +89,6 @@ void MirrorNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &ha
     Node::deserialize(json, hash);
     if(json.contains("direction")) {
         updateDirection(json["direction"].toInt());
-        propertiesPanel->setProperty("startDirection", m_direction);
     }
 }
 
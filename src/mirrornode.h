@@ -35,6 +35,7 @@ public:
     void saveTexture(QString fileName);
     void serialize(QJsonObject &json) const;
     void deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash);
+    bool uvStage(UVStage &stage, Socket *&source);
     int direction();
     void setDirection(int dir);
 signals:
@@ -44,6 +45,8 @@ public slots:
     void previewGenerated();
     void setOutput();
     void updateDirection(int dir);
+protected:
+    void setupPropertyPanel();
 private:
     MirrorObject *preview;
     int m_direction = 0;
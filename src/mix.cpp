@@ -20,11 +20,11 @@
  */
 
 #include "mix.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include <iostream>
 
 MixObject::MixObject(QQuickItem *parent, QVector2D resolution, float factor, int mode, bool includingAlpha):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_factor(factor), m_mode(mode), m_includingAlpha(includingAlpha)
+    ThumbnailObject(parent), m_resolution(resolution), m_factor(factor), m_mode(mode), m_includingAlpha(includingAlpha)
 {
 }
 
@@ -114,20 +114,11 @@ MixRenderer::~MixRenderer() {
 MixRenderer::MixRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
 
-    mixShader = new QOpenGLShaderProgram();
-    mixShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    mixShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/mix.frag");
-    mixShader->link();
+    mixShader = createShaderProgram(PROGRAM_MIX);
 
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
 
-    renderTexture = new QOpenGLShaderProgram();
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    renderTexture->link();
+    renderTexture = createShaderProgram(PROGRAM_TEXTURE);
 
     mixShader->bind();
     mixShader->setUniformValue(mixShader->uniformLocation("firstTexture"), 0);
@@ -171,14 +162,8 @@ MixRenderer::MixRenderer(QVector2D resolution): m_resolution(resolution) {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-QOpenGLFramebufferObject *MixRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void MixRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     MixObject *mixItem = static_cast<MixObject*>(item);
     if(mixItem->resUpdated) {
         mixItem->resUpdated = false;
@@ -214,7 +199,7 @@ void MixRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void MixRenderer::render() {
+void MixRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
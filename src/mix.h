@@ -21,12 +21,12 @@
 
 #ifndef MIX_H
 #define MIX_H
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class MixObject: public QQuickFramebufferObject
+class MixObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -69,13 +69,12 @@ private:
     unsigned int m_maskTexture = 0;
 };
 
-class MixRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class MixRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     MixRenderer(QVector2D resolution);
     ~MixRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();   
+    void renderPreview();   
 private:
     void mix();
     void updateTextureRes();
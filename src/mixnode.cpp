@@ -44,22 +44,22 @@ MixNode::MixNode(QQuickItem *parent, QVector2D resolution, float factor, int mod
     connect(this, &MixNode::generatePreview, this, &MixNode::previewGenerated);
     connect(preview, &MixObject::updatePreview, this, &MixNode::updatePreview);
     connect(this, &Node::changeResolution, preview, &MixObject::setResolution);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/MixProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    connect(propertiesPanel, SIGNAL(factorChanged(qreal)), this, SLOT(updateFactor(qreal)));
-    connect(propertiesPanel, SIGNAL(modeChanged(int)), this, SLOT(updateMode(int)));
-    connect(propertiesPanel, SIGNAL(includingAlphaChanged(bool)), this, SLOT(updateIncludingAlpha(bool)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-    propertiesPanel->setProperty("startFactor", m_factor);
-    propertiesPanel->setProperty("startMode", m_mode);
-    propertiesPanel->setProperty("startIncludingAlpha", m_includingAlpha);
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/MixProperty.qml"));
 }
 
 MixNode::~MixNode() {
     delete preview;
 }
 
+void MixNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startFactor", m_factor);
+    propertiesPanel->setProperty("startMode", m_mode);
+    propertiesPanel->setProperty("startIncludingAlpha", m_includingAlpha);
+    connect(propertiesPanel, SIGNAL(factorChanged(qreal)), this, SLOT(updateFactor(qreal)));
+    connect(propertiesPanel, SIGNAL(modeChanged(int)), this, SLOT(updateMode(int)));
+    connect(propertiesPanel, SIGNAL(includingAlphaChanged(bool)), this, SLOT(updateIncludingAlpha(bool)));
+}
+
 void MixNode::operation() {
 
     preview->setFirstTexture((m_socketsInput[0]->value().toUInt()));
@@ -134,35 +134,32 @@ void MixNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash)
     Node::deserialize(json, hash);
     if(json.contains("factor")) {
         setFactor(json["factor"].toVariant().toFloat());
-        propertiesPanel->setProperty("startFactor", m_factor);
     }
     if(json.contains("mode")) {
         setMode(json["mode"].toInt());
-        propertiesPanel->setProperty("startMode", m_mode);
     }
     if(json.contains("includingAlpha")) {
         setIncludingAlpha(json["includingAlpha"].toBool());
-        propertiesPanel->setProperty("startIncludingAlpha", m_includingAlpha);
     }
 }
 
 void MixNode::updateFactor(qreal f) {
     setFactor(static_cast<float>(f));
     if(m_socketsInput[2]->countEdge() == 0) {
-        operation();
+        requestOperation();
     }
     dataChanged();
 }
 
 void MixNode::updateMode(int mode) {
     setMode(mode);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void MixNode::updateIncludingAlpha(bool including) {
     setIncludingAlpha(including);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
@@ -52,6 +52,8 @@ public slots:
     void updateMode(int mode);
     void updateIncludingAlpha(bool including);
     void updateScale(float scale);
+protected:
+    void setupPropertyPanel();
 private:
     MixObject *preview = nullptr;
     float m_factor = 0.5;
@@ -21,6 +21,7 @@
 
 #include "node.h"
 #include "scene.h"
+#include "thumbnail.h"
 #include <iostream>
 #include <QQmlProperty>
 
@@ -28,10 +29,10 @@ Node::Node(QQuickItem *parent, QVector2D resolution): QQuickItem (parent), m_res
 {
     setAcceptedMouseButtons(Qt::AllButtons);
     setAcceptHoverEvents(true);
-    view = new QQuickView();
-    view->setSource(QUrl(QStringLiteral("qrc:/qml/Node.qml")));
-    grNode = qobject_cast<QQuickItem *>(view->rootObject());
-    grNode->setParentItem(this);
+    grNode = createItem(QUrl(QStringLiteral("qrc:/qml/Node.qml")), this);
+    // keep the node usable without its chrome rather than crash on every access
+    if(!grNode) grNode = new QQuickItem(this);
+    grNode->setProperty("detail", m_detail);
     grNode->setX(8);
     setZ(3);
 }
@@ -57,9 +58,7 @@ Node::~Node() {
     }
 
     delete grNode;
-    delete view;
     delete propertiesPanel;
-    delete propView;
 }
 
 float Node::baseX() {
@@ -68,19 +67,8 @@ float Node::baseX() {
 
 void Node::setBaseX(float value) {
     m_baseX = value;
-    setX(m_baseX*m_scale - m_pan.x());
-    for(auto s: m_socketsInput) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 6, s->y() + 6));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
-    for(auto s: m_socketOutput) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 6, s->y() + 6));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
-    for(auto s: m_additionalInputs) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
+    setX(m_baseX*m_scale);
+    updateSockets();
     if(m_attachedFrame && !m_attachedFrame->selected()) {
         m_attachedFrame->resizeByContent();
     }
@@ -93,46 +81,21 @@ float Node::baseY() {
 
 void Node::setBaseY(float value) {
     m_baseY = value;
-    setY(m_baseY*m_scale - m_pan.y());
-    for(auto s: m_socketsInput) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
-    for(auto s: m_socketOutput) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
-    for(auto s: m_additionalInputs) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
+    setY(m_baseY*m_scale);
+    updateSockets();
     if(m_attachedFrame && !m_attachedFrame->selected()) {
         m_attachedFrame->resizeByContent();
     }
     emit changeBaseY(value);
 }
 
-QVector2D Node::pan() {
-    return m_pan;
-}
-
-void Node::setPan(QVector2D pan) {
-    m_pan = pan;
-    setX(baseX()*m_scale - m_pan.x());
-    setY(baseY()*m_scale - m_pan.y());
-    for(auto s: m_socketsInput) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
-    for(auto s: m_socketOutput) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
-    for(auto s: m_additionalInputs) {
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
-    }
-    emit changePan(pan);
+void Node::setBasePosition(QVector2D pos) {
+    m_baseX = pos.x();
+    m_baseY = pos.y();
+    setPosition(QPointF(m_baseX*m_scale, m_baseY*m_scale));
+    updateSockets();
+    emit changeBaseX(m_baseX);
+    emit changeBaseY(m_baseY);
 }
 
 void Node::setResolution(QVector2D res) {
@@ -220,9 +183,24 @@ QList<Edge*> Node::getEdges() const {
 }
 
 QQuickItem *Node::getPropertyPanel() {
+    if(!propertiesPanel && !propertiesPanelSource.isEmpty()) {
+        propertiesPanel = createItem(propertiesPanelSource);
+        if(!propertiesPanel) return nullptr;
+        setupPropertyPanel();
+        connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    }
     return propertiesPanel;
 }
 
+void Node::releasePropertyPanel() {
+    if(!propertiesPanel) return;
+    propertiesPanel->deleteLater();
+    propertiesPanel = nullptr;
+}
+
+void Node::setupPropertyPanel() {
+}
+
 Frame *Node::attachedFrame() {
     return m_attachedFrame;
 }
@@ -239,8 +217,7 @@ void Node::mousePressEvent(QMouseEvent *event) {
     setFocus(true);
     setFocus(false);
     moved = false;
-    Scene *scene = reinterpret_cast<Scene*>(parentItem());
-    QPointF point = mapToItem(scene, QPointF(event->pos().x(), event->pos().y())); 
+    Scene *scene = Scene::sceneOf(this);
     dragX = event->pos().x();
     dragY = event->pos().y();
     oldX = m_baseX;
@@ -277,26 +254,14 @@ void Node::mouseMoveEvent(QMouseEvent *event) {
             moved = true;
         }
 
-        Scene* scene = reinterpret_cast<Scene*>(parentItem());
+        Scene* scene = Scene::sceneOf(this);
         scene->isNodesDrag = true;
-        QPointF point = mapToItem(scene, QPointF(event->pos().x(), event->pos().y()));
+        QPointF point = mapToItem(parentItem(), QPointF(event->pos().x(), event->pos().y()));
         setX(point.x() - dragX);
         setY(point.y() - dragY);
-        int offsetBaseX = m_baseX - (x() + m_pan.x())/m_scale;
-        int offsetBaseY = m_baseY - (y() + m_pan.y())/m_scale;
-        for(int i = 0; i < scene->countSelected(); ++i) {
-            QQuickItem *item = scene->atSelected(i);
-            if(qobject_cast<Node*>(item)) {
-                Node *n = qobject_cast<Node*>(item);
-                n->setBaseX(n->baseX() - offsetBaseX);
-                n->setBaseY(n->baseY() - offsetBaseY);
-            }
-            else if(qobject_cast<Frame*>(item)) {
-                Frame *f = qobject_cast<Frame*>(item);
-                f->setBaseX(f->baseX() - offsetBaseX);
-                f->setBaseY(f->baseY() - offsetBaseY);
-            }
-        }
+        int offsetBaseX = m_baseX - x()/m_scale;
+        int offsetBaseY = m_baseY - y()/m_scale;
+        scene->moveItems(scene->selectedList(), QVector2D(-offsetBaseX, -offsetBaseY));
     }
 }
 
@@ -304,7 +269,7 @@ void Node::mouseReleaseEvent(QMouseEvent *event) {
     if(event->button() == Qt::LeftButton && event->modifiers() != Qt::ControlModifier) {
         QVector2D offset(m_baseX - oldX, m_baseY - oldY);
 
-        Scene* scene = reinterpret_cast<Scene*>(parentItem());
+        Scene* scene = Scene::sceneOf(this);
         if(!moved && m_selected){
             QList<QQuickItem*> selected = scene->selectedList();
             if(selected.size() > 1) {
@@ -411,7 +376,7 @@ void Node::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
             hash[s->id()] = s;
         }
     }
-    operation();
+    requestOperation();
 }
 
 void Node::createSockets(int inputCount, int outputCount) {
@@ -425,8 +390,7 @@ void Node::createSockets(int inputCount, int outputCount) {
         s->setY(inputStart + 42*m_scale*i);
         s->setX(2*m_scale);
         s->updateScale(m_scale);
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
+        s->setDetailed(m_detail == FULL_DETAIL);
         m_socketsInput.append(s);
     }
     for(int i = 0; i < outputCount; ++i) {
@@ -436,24 +400,21 @@ void Node::createSockets(int inputCount, int outputCount) {
         s->setY(outputStart + 42*m_scale*i);
         s->setX(178*m_scale);
         s->updateScale(m_scale);
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8, s->y() + 8));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
+        s->setDetailed(m_detail == FULL_DETAIL);
         m_socketOutput.append(s);
     }
 }
 
 void Node::createAdditionalInputs(int count) {
-    m_additionalInputs.clear();
     float start = grNode->height() + 12*m_scale;
-    for(int i = 0; i < count; ++i) {
+    for(int i = m_additionalInputs.size(); i < count; ++i) {
         Socket *s = new Socket(this);
         s->setType(INPUTS);
         s->setAdditional(true);
         s->setY(start + 28*m_scale*i);
         s->setX(2*m_scale);
         s->updateScale(m_scale);
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*m_scale, s->y() + 8*m_scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
+        s->setDetailed(m_detail == FULL_DETAIL);
         m_additionalInputs.append(s);
     }
 }
@@ -462,12 +423,39 @@ void Node::setTitle(QString title) {
     grNode->setProperty("title", title);
 }
 
+detailLevel Node::detail() {
+    return m_detail;
+}
+
+void Node::setDetail(detailLevel level) {
+    if(level == m_detail) return;
+    m_detail = level;
+    grNode->setProperty("detail", level);
+    for(QQuickItem *item: grNode->childItems()) {
+        ThumbnailObject *thumbnail = qobject_cast<ThumbnailObject*>(item);
+        if(thumbnail) thumbnail->setThumbnailVisible(level == FULL_DETAIL);
+    }
+    for(auto s: m_socketsInput) {
+        s->setDetailed(level == FULL_DETAIL);
+    }
+    for(auto s: m_socketOutput) {
+        s->setDetailed(level == FULL_DETAIL);
+    }
+    for(auto s: m_additionalInputs) {
+        s->setDetailed(level == FULL_DETAIL);
+    }
+}
+
 void Node::setPropertyOnPanel(const char *name, QVariant value) {
-    propertiesPanel->setProperty(name, value);
+    bool temporary = !propertiesPanel;
+    QQuickItem *panel = getPropertyPanel();
+    if(!panel) return;
+    panel->setProperty(name, value);
+    if(temporary) releasePropertyPanel();
 }
 
 void Node::propertyChanged(QString propName, QVariant newValue, QVariant oldValue) {
-    Scene* scene = reinterpret_cast<Scene*>(parentItem());
+    Scene* scene = Scene::sceneOf(this);
     if(scene) {
         std::string prop = propName.toStdString();
         char *name = new char[prop.size() + 1];
@@ -481,6 +469,101 @@ void Node::operation() {
 
 }
 
+void Node::requestOperation() {
+    Scene *scene = Scene::sceneOf(this);
+    if(scene) scene->invalidateOutputHash(this);
+    if(scene && scene->evaluationSuspended()) scene->deferOperation(this);
+    else if(m_outputRestored && scene && scene->outputUnchanged(this)) return;
+    else operation();
+}
+
+QUuid Node::outputId() const {
+    if(m_socketOutput.count() != 1) return QUuid();
+    return m_socketOutput[0]->id();
+}
+
+void Node::captureOutput(bool pixels) {
+    ThumbnailObject *object = outputObject();
+    unsigned int texture = outputTexture();
+    if(!object || !texture || m_socketOutput.count() != 1) {
+        emit outputCaptured(QByteArray(), QSize());
+        return;
+    }
+    connect(object, &ThumbnailObject::outputCaptured, this, &Node::outputCaptured, Qt::UniqueConnection);
+    object->requestOutput(texture, pixels);
+}
+
+bool Node::restoreOutput(QByteArray data, QSize size) {
+    ThumbnailObject *object = outputObject();
+    if(!object || m_socketOutput.count() != 1) return false;
+    connect(object, &ThumbnailObject::outputRestored, this, &Node::restoredOutput, Qt::UniqueConnection);
+    markOutputRestored();
+    object->restoreOutput(data, size);
+    return true;
+}
+
+void Node::detachRestoreData() {
+    ThumbnailObject *object = outputObject();
+    if(object) object->detachRestoreData();
+}
+
+bool Node::copyOutput(Node *source) {
+    ThumbnailObject *object = outputObject();
+    unsigned int texture = source->outputTexture();
+    if(!object || !texture || m_socketOutput.count() != 1) return false;
+    connect(object, &ThumbnailObject::outputRestored, this, &Node::restoredOutput, Qt::UniqueConnection);
+    markOutputRestored();
+    object->copyOutput(texture);
+    return true;
+}
+
+void Node::markOutputRestored() {
+    connect(this, &Node::updatePreview, this, &Node::previewUpdated, Qt::UniqueConnection);
+    m_outputRestored = true;
+}
+
+bool Node::outputRestored() {
+    return m_outputRestored;
+}
+
+void Node::restoredOutput(unsigned int texture) {
+    if(!m_outputRestored) return;
+    if(!texture) {
+        m_outputRestored = false;
+        ThumbnailObject *object = outputObject();
+        if(object) object->setOutputRestored(false);
+        Scene *scene = Scene::sceneOf(this);
+        if(scene) scene->outputInvalidated(this);
+        operation();
+        return;
+    }
+    m_restoredTexture = texture;
+    m_socketOutput[0]->setValue(texture);
+    emit updatePreview(texture);
+}
+
+void Node::previewUpdated(unsigned int texture) {
+    if(!m_outputRestored || texture == m_restoredTexture) return;
+    m_outputRestored = false;
+    m_restoredTexture = 0;
+    ThumbnailObject *object = outputObject();
+    if(object) object->setOutputRestored(false);
+    Scene *scene = Scene::sceneOf(this);
+    if(scene) scene->outputInvalidated(this);
+}
+
+ThumbnailObject *Node::outputObject() {
+    for(QQuickItem *item: grNode->childItems()) {
+        ThumbnailObject *thumbnail = qobject_cast<ThumbnailObject*>(item);
+        if(thumbnail) return thumbnail;
+    }
+    return nullptr;
+}
+
+unsigned int Node::outputTexture() {
+    return m_outputRestored ? m_restoredTexture : getPreviewTexture();
+}
+
 unsigned int &Node::getPreviewTexture() {
     return previewTex;
 }
@@ -489,7 +572,19 @@ void Node::saveTexture(QString fileName) {
 
 }
 
+bool Node::uvStage(UVStage &stage, Socket *&source) {
+    Q_UNUSED(stage)
+    Q_UNUSED(source)
+    return false;
+}
+
+bool Node::costlyOperation() const {
+    return false;
+}
+
 void Node::scaleUpdate(float scale) {
+    setX(m_baseX*scale);
+    setY(m_baseY*scale);
     setWidth(196*static_cast<qreal>(scale));
     setHeight(207*static_cast<qreal>(scale));
     grNode->setHeight(207*scale);
@@ -503,25 +598,32 @@ void Node::scaleUpdate(float scale) {
         s->updateScale(scale);
         s->setY(inputStart + 42*scale*i);
         s->setX(2*scale);
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*scale, s->y() + 8*scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
     }
     for(int i = 0; i < outputCount; ++i) {
         Socket *s = m_socketOutput[i];
         s->updateScale(scale);
         s->setY(outputStart + 42*scale*i);
         s->setX(178*scale);
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*scale, s->y() + 8*scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
     }
     for(int i = 0; i < m_additionalInputs.length(); ++i) {
         Socket *s = m_additionalInputs[i];
         s->updateScale(scale);
         s->setY(grNode->height() + 12*scale + 28*i*scale);
         s->setX(2*scale);
-        QPointF sPos = mapToItem(parentItem(), QPointF(s->x() + 8*scale, s->y() + 8*scale));
-        s->setGlobalPos(QVector2D(sPos.x(), sPos.y()));
     }
     m_scale = scale;
+    updateSockets();
     changeScaleView(scale);
 }
+
+void Node::updateSockets() {
+    for(auto s: m_socketsInput) {
+        s->updateGlobalPos();
+    }
+    for(auto s: m_socketOutput) {
+        s->updateGlobalPos();
+    }
+    for(auto s: m_additionalInputs) {
+        s->updateGlobalPos();
+    }
+}
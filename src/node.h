@@ -22,19 +22,22 @@
 #ifndef NODE_H
 #define NODE_H
 #include <QQuickItem>
-#include <QQuickView>
+#include "components.h"
 #include <QJsonObject>
 #include <QJsonArray>
 #include "socket.h"
+#include "uvchain.h"
 
 class Frame;
+class ThumbnailObject;
+
+enum detailLevel {FULL_DETAIL, PLACEHOLDER, CULLED};
 
 class Node: public QQuickItem
 {
     Q_OBJECT
     Q_PROPERTY(float baseX READ baseX WRITE setBaseX NOTIFY changeBaseX)
     Q_PROPERTY(float baseY READ baseY WRITE setBaseY NOTIFY changeBaseY)
-    Q_PROPERTY(QVector2D pan READ pan WRITE setPan NOTIFY changePan)
     Q_PROPERTY(bool selected READ selected WRITE setSelected NOTIFY changeSelected)
 public:
     Node(QQuickItem *parent = nullptr, QVector2D resolution = QVector2D(1024, 1024));
@@ -44,8 +47,7 @@ public:
     void setBaseX(float value);
     float baseY();
     void setBaseY(float value);
-    QVector2D pan();
-    void setPan(QVector2D pan);
+    void setBasePosition(QVector2D pos);
     void setResolution(QVector2D res);
     float scaleView();
     bool selected();
@@ -53,6 +55,7 @@ public:
     bool checkConnected(Node* node, socketType type);
     QList<Edge*> getEdges() const;
     QQuickItem *getPropertyPanel();
+    void releasePropertyPanel();
     Frame *attachedFrame();
     void setAttachedFrame(Frame *frame);
     void mousePressEvent(QMouseEvent *event);
@@ -66,44 +69,64 @@ public:
     void createSockets(int inputCount, int outputCount);
     void createAdditionalInputs(int count);
     void setTitle(QString title);
+    detailLevel detail();
+    void setDetail(detailLevel level);
     virtual void operation();
+    void requestOperation();
+    QUuid outputId() const;
+    void captureOutput(bool pixels = true);
+    bool restoreOutput(QByteArray data, QSize size);
+    void detachRestoreData();
+    bool copyOutput(Node *source);
+    void markOutputRestored();
+    bool outputRestored();
     virtual unsigned int &getPreviewTexture();
     virtual void saveTexture(QString fileName);
+    virtual bool uvStage(UVStage &stage, Socket *&source);
+    virtual bool costlyOperation() const;
 public slots:
     void scaleUpdate(float scale);
     void propertyChanged(QString propName, QVariant newValue, QVariant oldValue);
+private slots:
+    void restoredOutput(unsigned int texture);
+    void previewUpdated(unsigned int texture);
 signals:
     void changeBaseX(float value);
     void changeBaseY(float value);
-    void changePan(QVector2D pan);
     void changeResolution(QVector2D res);
     void changeSelected(bool select);
     void changeScaleView(float scale);
     void updatePreview(unsigned int previewData);
     void dataChanged();
     void generatePreview();
+    void outputCaptured(QByteArray data, QSize size);
 protected:
+    virtual void setupPropertyPanel();
     QQuickItem *grNode = nullptr;
     QQuickItem *propertiesPanel = nullptr;
-    QQuickView *propView = nullptr;
+    QUrl propertiesPanelSource;
     QVector<Socket *> m_socketsInput;
     QVector<Socket *> m_socketOutput;
     QVector<Socket *> m_additionalInputs;
     QVector2D m_resolution;
 private:
-    QQuickView *view;
+    void updateSockets();
+    ThumbnailObject *outputObject();
+    unsigned int outputTexture();
     Frame *m_attachedFrame = nullptr;
     float m_baseX = 0;
     float m_baseY = 0;
     float m_scale = 1.0f;
-    QVector2D m_pan = QVector2D(0, 0);
     bool m_selected = false;
+    detailLevel m_detail = CULLED;
     float dragX = 0.0f;
     float dragY = 0.0f;
     float oldX;
     float oldY;
     bool moved = false;
     unsigned int previewTex = 0;
+    bool m_outputRestored = false;
+    unsigned int m_restoredTexture = 0;
 };
 
 
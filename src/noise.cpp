@@ -20,12 +20,15 @@
  */
 
 #include "noise.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include <iostream>
 
+const qint64 maxLayersBytes = 64*1024*1024;
+const qint64 maxLayersBudgetScale = 4;
+
 NoiseObject::NoiseObject(QQuickItem *parent, QVector2D resolution, QString type, float noiseScale,
                          float scaleX, float scaleY, int layers, float persistence, float amplitude,
-                         int seed): QQuickFramebufferObject (parent), m_noiseType(type),
+                         int seed): ThumbnailObject(parent), m_noiseType(type),
     m_noiseScale(noiseScale), m_scaleX(scaleX), m_scaleY(scaleY), m_layers(layers),
     m_persistence(persistence), m_amplitude(amplitude), m_seed(seed), m_resolution(resolution)
 {
@@ -154,25 +157,23 @@ void NoiseObject::setTexture(unsigned int texture) {
 NoiseRenderer::NoiseRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
 
-    generateNoise = new QOpenGLShaderProgram();
-    generateNoise->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/noise.vert");
-    generateNoise->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/noise.frag");
-    generateNoise->link();
+    generateNoise = createShaderProgram(PROGRAM_NOISE);
+
+    combineLayers = createShaderProgram(PROGRAM_NOISE_LAYERS);
 
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
 
-    renderTexture = new QOpenGLShaderProgram();
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    renderTexture->link();
+    renderTexture = createShaderProgram(PROGRAM_TEXTURE);
 
     generateNoise->bind();
     generateNoise->setUniformValue(generateNoise->uniformLocation("maskTexture"), 0);
     generateNoise->release();
 
+    combineLayers->bind();
+    combineLayers->setUniformValue(combineLayers->uniformLocation("layersTexture"), 0);
+    combineLayers->setUniformValue(combineLayers->uniformLocation("maskTexture"), 1);
+    combineLayers->release();
+
     renderTexture->bind();
     renderTexture->setUniformValue(renderTexture->uniformLocation("texture"), 0);
     renderTexture->release();
@@ -222,23 +223,22 @@ NoiseRenderer::NoiseRenderer(QVector2D resolution): m_resolution(resolution) {
     glBindTexture(GL_TEXTURE_2D, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+    glGenFramebuffers(1, &layersFBO);
+
     //createNoise();
 }
 
 NoiseRenderer::~NoiseRenderer() {
+    glDeleteTextures(1, &layersTexture);
+    glDeleteFramebuffers(1, &layersFBO);
     delete generateNoise;
+    delete combineLayers;
     delete checkerShader;
     delete renderTexture;
 }
 
-QOpenGLFramebufferObject *NoiseRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void NoiseRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     NoiseObject *noiseItem = static_cast<NoiseObject*>(item);
     if(noiseItem->resUpdated) {
         noiseItem->resUpdated = false;
@@ -251,18 +251,29 @@ void NoiseRenderer::synchronize(QQuickFramebufferObject *item) {
     }
     if(noiseItem->generatedNoise) {
         noiseItem->generatedNoise = false;
-        m_noiseType = noiseItem->noiseType();
+        if(m_noiseType != noiseItem->noiseType() || m_noiseScale != noiseItem->noiseScale() ||
+           m_scaleX != noiseItem->scaleX() || m_scaleY != noiseItem->scaleY() || m_seed != noiseItem->seed()) {
+            m_noiseType = noiseItem->noiseType();
+            m_noiseScale = noiseItem->noiseScale();
+            m_scaleX = noiseItem->scaleX();
+            m_scaleY = noiseItem->scaleY();
+            m_seed = noiseItem->seed();
+            layersCount = 0;
+            generateNoise->bind();
+            generateNoise->setUniformValue(generateNoise->uniformLocation("scale"), m_noiseScale);
+            generateNoise->setUniformValue(generateNoise->uniformLocation("scaleX"), m_scaleX);
+            generateNoise->setUniformValue(generateNoise->uniformLocation("scaleY"), m_scaleY);
+            generateNoise->setUniformValue(generateNoise->uniformLocation("seed"), m_seed);
+            generateNoise->release();
+        }
+        m_layers = noiseItem->layers();
+        m_persistence = noiseItem->persistence();
+        m_amplitude = noiseItem->amplitude();
         m_maskTexture = noiseItem->maskTexture();
-        generateNoise->bind();
-        generateNoise->setUniformValue(generateNoise->uniformLocation("scale"), noiseItem->noiseScale());
-        generateNoise->setUniformValue(generateNoise->uniformLocation("scaleX"), noiseItem->scaleX());
-        generateNoise->setUniformValue(generateNoise->uniformLocation("scaleY"), noiseItem->scaleY());
-        generateNoise->setUniformValue(generateNoise->uniformLocation("octaves"), noiseItem->layers());
-        generateNoise->setUniformValue(generateNoise->uniformLocation("persistence"), noiseItem->persistence());
-        generateNoise->setUniformValue(generateNoise->uniformLocation("amplitude"), noiseItem->amplitude());
-        generateNoise->setUniformValue(generateNoise->uniformLocation("seed"), noiseItem->seed());
-        generateNoise->setUniformValue(generateNoise->uniformLocation("res"), m_resolution);
-        generateNoise->setUniformValue(generateNoise->uniformLocation("useMask"), m_maskTexture);
+        combineLayers->bind();
+        combineLayers->setUniformValue(combineLayers->uniformLocation("persistence"), m_persistence);
+        combineLayers->setUniformValue(combineLayers->uniformLocation("useMask"), m_maskTexture);
+        combineLayers->release();
         createNoise();
         noiseItem->setTexture(noiseTexture);
         noiseItem->updatePreview(noiseTexture);
@@ -273,7 +284,7 @@ void NoiseRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void NoiseRenderer::render() {
+void NoiseRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -299,20 +310,97 @@ void NoiseRenderer::render() {
 void NoiseRenderer::createNoise() {
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_BLEND);
+    updateLayers();
     glBindFramebuffer(GL_FRAMEBUFFER, noiseFBO);
     glViewport(0, 0, m_resolution.x(), m_resolution.y());
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
-    generateNoise->bind();
-    generateNoise->setUniformValue(generateNoise->uniformLocation("res"), m_resolution);
-    GLuint index = glGetSubroutineIndex(generateNoise->programId(), GL_FRAGMENT_SHADER, m_noiseType.toStdString().c_str());
-    glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 1, &index);
+    if(singlePass) {
+        generateNoise->bind();
+        generateNoise->setUniformValue(generateNoise->uniformLocation("res"), m_resolution);
+        generateNoise->setUniformValue(generateNoise->uniformLocation("layer"), 0);
+        generateNoise->setUniformValue(generateNoise->uniformLocation("octaves"), m_layers);
+        generateNoise->setUniformValue(generateNoise->uniformLocation("persistence"), m_persistence);
+        generateNoise->setUniformValue(generateNoise->uniformLocation("amplitude"), m_amplitude);
+        generateNoise->setUniformValue(generateNoise->uniformLocation("combined"), true);
+        generateNoise->setUniformValue(generateNoise->uniformLocation("useMask"), m_maskTexture);
+        GLuint index = glGetSubroutineIndex(generateNoise->programId(), GL_FRAGMENT_SHADER, m_noiseType.toStdString().c_str());
+        glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 1, &index);
+        glBindVertexArray(noiseVAO);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, m_maskTexture);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindVertexArray(0);
+        generateNoise->release();
+        return;
+    }
+    combineLayers->bind();
+    combineLayers->setUniformValue(combineLayers->uniformLocation("res"), m_resolution);
+    combineLayers->setUniformValue(combineLayers->uniformLocation("octaves"), m_layers);
+    combineLayers->setUniformValue(combineLayers->uniformLocation("amplitude"), m_amplitude);
     glBindVertexArray(noiseVAO);
     glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, layersTexture);
+    glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, m_maskTexture);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindTexture(GL_TEXTURE_2D, 0);
-    glBindVertexArray(0);    
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glBindVertexArray(0);
+    combineLayers->release();
+}
+
+void NoiseRenderer::updateLayers() {
+    int needed = m_layers + 1;
+    // octaves are kept as 8 bit slices within a budget that grows with the resolution,
+    // past it the noise is drawn in one pass like before the octaves were cached
+    qint64 pixels = static_cast<qint64>(m_resolution.x())*static_cast<qint64>(m_resolution.y());
+    qint64 budget = maxLayersBytes*qBound<qint64>(1, pixels/(2048*2048), maxLayersBudgetScale);
+    singlePass = needed*pixels > budget;
+    if(singlePass) {
+        glDeleteTextures(1, &layersTexture);
+        layersTexture = 0;
+        layersCapacity = 0;
+        layersCount = 0;
+        return;
+    }
+    if(needed > layersCapacity) {
+        unsigned int texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_R8, m_resolution.x(), m_resolution.y(), needed);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        if(layersCount > 0) {
+            glCopyImageSubData(layersTexture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                               m_resolution.x(), m_resolution.y(), layersCount);
+        }
+        glDeleteTextures(1, &layersTexture);
+        layersTexture = texture;
+        layersCapacity = needed;
+    }
+    if(layersCount >= needed) return;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, layersFBO);
+    glViewport(0, 0, m_resolution.x(), m_resolution.y());
+    generateNoise->bind();
+    generateNoise->setUniformValue(generateNoise->uniformLocation("res"), m_resolution);
+    generateNoise->setUniformValue(generateNoise->uniformLocation("octaves"), 0);
+    generateNoise->setUniformValue(generateNoise->uniformLocation("amplitude"), 1.0f);
+    generateNoise->setUniformValue(generateNoise->uniformLocation("combined"), false);
+    GLuint index = glGetSubroutineIndex(generateNoise->programId(), GL_FRAGMENT_SHADER, m_noiseType.toStdString().c_str());
+    glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 1, &index);
+    glBindVertexArray(noiseVAO);
+    for(int i = layersCount; i < needed; ++i) {
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, layersTexture, 0, i);
+        generateNoise->setUniformValue(generateNoise->uniformLocation("layer"), i);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+    layersCount = needed;
+    glBindVertexArray(0);
     generateNoise->release();
 }
 
@@ -320,6 +408,10 @@ void NoiseRenderer::updateTexResolution() {
     glBindTexture(GL_TEXTURE_2D, noiseTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_resolution.x(), m_resolution.y(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glBindTexture(GL_TEXTURE_2D, 0);
+    glDeleteTextures(1, &layersTexture);
+    layersTexture = 0;
+    layersCapacity = 0;
+    layersCount = 0;
 }
 
 void NoiseRenderer::saveTexture(QString fileName) {
@@ -21,12 +21,12 @@
 
 #ifndef NOISE_H
 #define NOISE_H
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class NoiseObject: public QQuickFramebufferObject
+class NoiseObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -78,25 +78,38 @@ private:
     unsigned int m_maskTexture = 0;
 };
 
-class NoiseRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class NoiseRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     NoiseRenderer(QVector2D resolution);
     ~NoiseRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();   
+    void renderPreview();   
 private:
     void createNoise();
+    void updateLayers();
     void updateTexResolution();
     void saveTexture(QString fileName);
     QOpenGLShaderProgram *generateNoise;
+    QOpenGLShaderProgram *combineLayers;
     QOpenGLShaderProgram *checkerShader;
     QOpenGLShaderProgram *renderTexture;
     unsigned int noiseFBO;
+    unsigned int layersFBO;
     unsigned int noiseVAO, textureVAO;
     unsigned int noiseTexture = 0;
+    unsigned int layersTexture = 0;
+    int layersCapacity = 0;
+    int layersCount = 0;
+    bool singlePass = false;
     QVector2D m_resolution;
     QString m_noiseType;
+    float m_noiseScale = 0.0f;
+    float m_scaleX = 0.0f;
+    float m_scaleY = 0.0f;
+    int m_seed = 0;
+    int m_layers = 0;
+    float m_persistence = 0.5f;
+    float m_amplitude = 1.0f;
     unsigned int m_maskTexture = 0;
 };
 
@@ -49,9 +49,14 @@ NoiseNode::NoiseNode(QQuickItem *parent, QVector2D resolution, NoiseParams perli
     createSockets(1, 1);
     m_socketsInput[0]->setTip("Mask");
     setTitle("Noise");
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/NoiseProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/NoiseProperty.qml"));
+}
+
+NoiseNode::~NoiseNode() {
+    delete preview;
+}
+
+void NoiseNode::setupPropertyPanel() {
     int index = 0;
     if(m_noiseType == "noiseSimple") index = 1;
     propertiesPanel->setProperty("type", index);
@@ -70,11 +75,6 @@ NoiseNode::NoiseNode(QQuickItem *parent, QVector2D resolution, NoiseParams perli
     connect(propertiesPanel, SIGNAL(amplitudeChanged(qreal)), this, SLOT(updateAmplitude(qreal)));
     connect(propertiesPanel, SIGNAL(seedChanged(int)), this, SLOT(updateSeed(int)));
     connect(propertiesPanel, SIGNAL(noiseTypeChanged(QString)), this, SLOT(updateNoiseType(QString)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-}
-
-NoiseNode::~NoiseNode() {
-    delete preview;
 }
 
 QString NoiseNode::noiseType() {
@@ -82,14 +82,23 @@ QString NoiseNode::noiseType() {
 }
 
 void NoiseNode::setNoiseType(QString type) {
-    m_noiseType = type;    
-    propertiesPanel->setProperty("startNoiseScale", noiseScale());
-    propertiesPanel->setProperty("startScaleX", scaleX());
-    propertiesPanel->setProperty("startScaleY", scaleY());
-    propertiesPanel->setProperty("startLayers", layers());
-    propertiesPanel->setProperty("startPersistence", persistence());
-    propertiesPanel->setProperty("startAmplitude", amplitude());
-    propertiesPanel->setProperty("startSeed", seed());
+    m_noiseType = type;
+    noiseScaleChanged(noiseScale());
+    scaleXChanged(scaleX());
+    scaleYChanged(scaleY());
+    layersChanged(layers());
+    persistenceChanged(persistence());
+    amplitudeChanged(amplitude());
+    seedChanged(seed());
+    if(propertiesPanel) {
+        propertiesPanel->setProperty("startNoiseScale", noiseScale());
+        propertiesPanel->setProperty("startScaleX", scaleX());
+        propertiesPanel->setProperty("startScaleY", scaleY());
+        propertiesPanel->setProperty("startLayers", layers());
+        propertiesPanel->setProperty("startPersistence", persistence());
+        propertiesPanel->setProperty("startAmplitude", amplitude());
+        propertiesPanel->setProperty("startSeed", seed());
+    }
     noiseTypeChanged(type);
 }
 
@@ -193,6 +202,10 @@ void NoiseNode::saveTexture(QString fileName) {
     preview->saveTexture(fileName);
 }
 
+bool NoiseNode::costlyOperation() const {
+    return true;
+}
+
 void NoiseNode::operation() {
     preview->selectedItem = selected();
     preview->setMaskTexture(m_socketsInput[0]->value().toUInt());
@@ -274,18 +287,8 @@ void NoiseNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &has
     }
     if(json.contains("noiseType")) {
         m_noiseType = json["noiseType"].toVariant().toString();
-        noiseTypeChanged(m_noiseType);
-        int index = 0;
-        if(m_noiseType == "noiseSimple") index = 1;
-        propertiesPanel->setProperty("type", index);
-        propertiesPanel->setProperty("startNoiseScale", noiseScale());
-        propertiesPanel->setProperty("startScaleX", scaleX());
-        propertiesPanel->setProperty("startScaleY", scaleY());
-        propertiesPanel->setProperty("startLayers", layers());
-        propertiesPanel->setProperty("startPersistence", persistence());
-        propertiesPanel->setProperty("startAmplitude", amplitude());
-        propertiesPanel->setProperty("startSeed", seed());
     }
+    setNoiseType(m_noiseType);
 }
 
 void NoiseNode::updateNoiseType(QString type) {
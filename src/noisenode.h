@@ -60,6 +60,7 @@ public:
     void setSeed(int seed);
     unsigned int &getPreviewTexture();
     void saveTexture(QString fileName);
+    bool costlyOperation() const;
     void operation();
     void serialize(QJsonObject &json) const;
     void deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash);
@@ -84,6 +85,8 @@ public slots:
     void updateSeed(int seed);
     void previewGenerated();
     void updateScale(float scale);
+protected:
+    void setupPropertyPanel();
 private:
     NoiseObject *preview = nullptr;
     QString m_noiseType = "perlinNoise";
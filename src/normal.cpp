@@ -20,10 +20,10 @@
  */
 
 #include "normal.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include "FreeImage.h"
 
-NormalObject::NormalObject(QQuickItem *parent, QVector2D resolution): QQuickFramebufferObject (parent),
+NormalObject::NormalObject(QQuickItem *parent, QVector2D resolution): ThumbnailObject(parent),
     m_resolution(resolution)
 {
 
@@ -58,10 +58,7 @@ void NormalObject::saveTexture(QString fileName) {
 NormalRenderer::NormalRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
 
-    renderNormal = new QOpenGLShaderProgram();
-    renderNormal->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    renderNormal->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    renderNormal->link();
+    renderNormal = createShaderProgram(PROGRAM_TEXTURE);
 
     renderNormal->bind();
     renderNormal->setUniformValue(renderNormal->uniformLocation("textureSample"), 0);
@@ -89,14 +86,8 @@ NormalRenderer::~NormalRenderer() {
     delete renderNormal;
 }
 
-QOpenGLFramebufferObject *NormalRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void NormalRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     NormalObject *normalItem = static_cast<NormalObject*>(item);
     m_normalTexture = normalItem->normalTexture();
     m_resolution = normalItem->resolution();
@@ -109,7 +100,7 @@ void NormalRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void NormalRenderer::render() {
+void NormalRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_BLEND);
     glClearColor(0.6f, 0.6f, 0.6f, 1.0f);
@@ -22,12 +22,12 @@
 #ifndef NORMAL_H
 #define NORMAL_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class NormalObject: public QQuickFramebufferObject
+class NormalObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -49,13 +49,12 @@ private:
     unsigned int m_normalMap = 0;
 };
 
-class NormalRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class NormalRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     NormalRenderer(QVector2D resolution);
     ~NormalRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void saveTexture(QString name);
     QOpenGLShaderProgram *renderNormal;
@@ -20,11 +20,11 @@
  */
 
 #include "normalmap.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include <iostream>
 
 NormalMapObject::NormalMapObject(QQuickItem *parent, QVector2D resolution, float strenght):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_strenght(strenght)
+    ThumbnailObject(parent), m_resolution(resolution), m_strenght(strenght)
 {
 
 }
@@ -81,15 +81,9 @@ void NormalMapObject::setNormalTexture(unsigned int texture) {
 NormalMapRenderer::NormalMapRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
 
-    normalMap = new QOpenGLShaderProgram();
-    normalMap->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/noise.vert");
-    normalMap->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/normalmap.frag");
-    normalMap->link();
+    normalMap = createShaderProgram(PROGRAM_NORMAL_MAP);
 
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
 
     normalMap->bind();
     normalMap->setUniformValue(normalMap->uniformLocation("grayscaleTexture"), 0);
@@ -150,14 +144,8 @@ NormalMapRenderer::~NormalMapRenderer() {
     delete normalMap;
 }
 
-QOpenGLFramebufferObject *NormalMapRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void NormalMapRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     NormalMapObject *normalItem = static_cast<NormalMapObject*>(item);    
     if(normalItem->resUpdated) {
         normalItem->resUpdated = false;
@@ -180,7 +168,7 @@ void NormalMapRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void NormalMapRenderer::render() {
+void NormalMapRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_BLEND);
     glClearColor(0.6f, 0.6f, 0.6f, 1.0f);
@@ -22,12 +22,12 @@
 #ifndef NORMALMAP_H
 #define NORMALMAP_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 #include "FreeImage.h"
 
-class NormalMapObject: public QQuickFramebufferObject
+class NormalMapObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -57,13 +57,12 @@ private:
     unsigned int m_normalTexture = 0;
 };
 
-class NormalMapRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class NormalMapRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     NormalMapRenderer(QVector2D resolution);
     ~NormalMapRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     unsigned int m_grayscaleTexture = 0;
     unsigned int m_normalTexture = 0;
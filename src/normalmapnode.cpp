@@ -34,24 +34,24 @@ NormalMapNode::NormalMapNode(QQuickItem *parent, QVector2D resolution, float str
     preview->setX(3*s);
     preview->setY(30*s);
     preview->setScale(s);
-    propView = new QQuickView();
     connect(preview, &NormalMapObject::textureChanged, this, &NormalMapNode::setOutput);
     connect(this, &NormalMapNode::generatePreview, this, &NormalMapNode::previewGenerated);
     connect(this, &NormalMapNode::strenghtChanged, preview, &NormalMapObject::setStrenght);
     connect(this, &Node::changeScaleView, this, &NormalMapNode::updateScale);
     connect(preview, &NormalMapObject::updatePreview, this, &NormalMapNode::updatePreview);
     connect(this, &Node::changeResolution, preview, &NormalMapObject::setResolution);
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/NormalMapProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    connect(propertiesPanel, SIGNAL(strenghtChanged(qreal)), this, SLOT(updateStrenght(qreal)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-    propertiesPanel->setProperty("startStrenght", m_strenght/30.0f);
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/NormalMapProperty.qml"));
 }
 
 NormalMapNode::~NormalMapNode() {
     delete preview;
 }
 
+void NormalMapNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startStrenght", m_strenght/30.0f);
+    connect(propertiesPanel, SIGNAL(strenghtChanged(qreal)), this, SLOT(updateStrenght(qreal)));
+}
+
 void NormalMapNode::operation() {
     preview->setGrayscaleTexture(m_socketsInput[0]->value().toUInt());
     preview->selectedItem = selected();
@@ -81,14 +81,13 @@ void NormalMapNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *>
     Node::deserialize(json, hash);
     if(json.contains("strength")) {
         updateStrenght(json["strength"].toVariant().toFloat());
-        propertiesPanel->setProperty("startStrenght", m_strenght/30.0f);
     }
 }
 
 void NormalMapNode::updateStrenght(qreal strenght) {
     m_strenght = static_cast<float>(strenght);
     strenghtChanged(m_strenght);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
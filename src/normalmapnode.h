@@ -44,6 +44,8 @@ public slots:
     void updateScale(float scale);
 signals:
     void strenghtChanged(float strenght);
+protected:
+    void setupPropertyPanel();
 private:
     NormalMapObject *preview;
     float m_strenght = 6.0f;
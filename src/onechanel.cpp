@@ -20,10 +20,10 @@
  */
 
 #include "onechanel.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include "FreeImage.h"
 
-OneChanelObject::OneChanelObject(QQuickItem *parent, QVector2D resolution): QQuickFramebufferObject (parent),
+OneChanelObject::OneChanelObject(QQuickItem *parent, QVector2D resolution): ThumbnailObject(parent),
     m_resolution(resolution)
 {
 
@@ -71,10 +71,7 @@ void OneChanelObject::setResolution(QVector2D res) {
 OneChanelRenderer::OneChanelRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
 
-    renderChanel = new QOpenGLShaderProgram();
-    renderChanel->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    renderChanel->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/onechanel.frag");
-    renderChanel->link();
+    renderChanel = createShaderProgram(PROGRAM_ONE_CHANNEL);
 
     float vertQuadTex[] = {-1.0f, -1.0f, 0.0f, 0.0f,
                     -1.0f, 1.0f, 0.0f, 1.0f,
@@ -118,14 +115,8 @@ OneChanelRenderer::~OneChanelRenderer() {
     delete renderChanel;
 }
 
-QOpenGLFramebufferObject *OneChanelRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void OneChanelRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     OneChanelObject *oneChanelItem = static_cast<OneChanelObject*>(item);
     renderChanel->bind();
     renderChanel->setUniformValue(renderChanel->uniformLocation("useTex"), oneChanelItem->useTex);
@@ -151,7 +142,7 @@ void OneChanelRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void OneChanelRenderer::render() {
+void OneChanelRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_ONE, GL_ZERO, GL_ZERO, GL_ONE);
@@ -22,11 +22,11 @@
 #ifndef ONECHANEL_H
 #define ONECHANEL_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 
-class OneChanelObject: public QQuickFramebufferObject
+class OneChanelObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -54,14 +54,13 @@ private:
     QVector2D m_resolution;
 };
 
-class OneChanelRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core
+class OneChanelRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core
 {
 public:
     OneChanelRenderer(QVector2D resolution);
     ~OneChanelRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void createColor();
     void saveTexture(QString fileName);
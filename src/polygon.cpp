@@ -20,12 +20,12 @@
  */
 
 #include "polygon.h"
-#include "QOpenGLFramebufferObjectFormat"
+#include "shaderwarmup.h"
 #include <iostream>
 #include "FreeImage.h"
 
 PolygonObject::PolygonObject(QQuickItem *parent, QVector2D resolution, int sides, float polygonScale,
-                             float smooth, bool useAlpha): QQuickFramebufferObject (parent),
+                             float smooth, bool useAlpha): ThumbnailObject(parent),
     m_resolution(resolution), m_sides(sides), m_scale(polygonScale), m_smooth(smooth), m_useAlpha(useAlpha)
 {
 
@@ -112,18 +112,9 @@ void PolygonObject::setResolution(QVector2D res) {
 
 PolygonRenderer::PolygonRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
-    generatePolygon = new QOpenGLShaderProgram();
-    generatePolygon->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/noise.vert");
-    generatePolygon->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/polygon.frag");
-    generatePolygon->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    renderTexture = new QOpenGLShaderProgram();
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    renderTexture->link();
+    generatePolygon = createShaderProgram(PROGRAM_POLYGON);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    renderTexture = createShaderProgram(PROGRAM_TEXTURE);
     generatePolygon->bind();
     generatePolygon->setUniformValue(generatePolygon->uniformLocation("maskTexture"), 0);
     generatePolygon->release();
@@ -183,14 +174,8 @@ PolygonRenderer::~PolygonRenderer() {
     delete renderTexture;
 }
 
-QOpenGLFramebufferObject *PolygonRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void PolygonRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     PolygonObject *polygonItem = static_cast<PolygonObject*>(item);
     if(polygonItem->resUpdated) {
         polygonItem->resUpdated = false;
@@ -221,7 +206,7 @@ void PolygonRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void PolygonRenderer::render() {
+void PolygonRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);    
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
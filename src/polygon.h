@@ -22,11 +22,11 @@
 #ifndef POLYGONT_H
 #define POLYGONT_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 
-class PolygonObject: public QQuickFramebufferObject
+class PolygonObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -65,13 +65,12 @@ private:
     bool m_useAlpha = true;
 };
 
-class PolygonRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class PolygonRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     PolygonRenderer(QVector2D resolution);
     ~PolygonRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void createPolygon();
     void updateTexResolution();
@@ -46,9 +46,14 @@ PolygonNode::PolygonNode(QQuickItem *parent, QVector2D resolution, int sides, fl
     createSockets(1, 1);
     m_socketsInput[0]->setTip("Mask");
     setTitle("Polygon");
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/PolygonProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/PolygonProperty.qml"));
+}
+
+PolygonNode::~PolygonNode() {
+    delete preview;
+}
+
+void PolygonNode::setupPropertyPanel() {
     propertiesPanel->setProperty("startSides", m_sides);
     propertiesPanel->setProperty("startScale", m_polygonScale);
     propertiesPanel->setProperty("startSmooth", m_smooth);
@@ -57,11 +62,6 @@ PolygonNode::PolygonNode(QQuickItem *parent, QVector2D resolution, int sides, fl
     connect(propertiesPanel, SIGNAL(polygonScaleChanged(qreal)), this, SLOT(updatePolygonScale(qreal)));
     connect(propertiesPanel, SIGNAL(polygonSmoothChanged(qreal)), this, SLOT(updateSmooth(qreal)));
     connect(propertiesPanel, SIGNAL(useAlphaChanged(bool)), this, SLOT(updateUseAlpha(bool)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-}
-
-PolygonNode::~PolygonNode() {
-    delete preview;
 }
 
 void PolygonNode::operation() {
@@ -89,21 +89,17 @@ void PolygonNode::serialize(QJsonObject &json) const {
 void PolygonNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
     Node::deserialize(json, hash);
     if(json.contains("sides")) {
-        m_sides = json["sides"].toVariant().toInt();
+        setSides(json["sides"].toVariant().toInt());
     }
     if(json.contains("scale")) {
-        m_polygonScale = json["scale"].toVariant().toFloat();
+        setPolygonScale(json["scale"].toVariant().toFloat());
     }
     if(json.contains("smooth")) {
-        m_smooth = json["smooth"].toVariant().toFloat();
+        setSmooth(json["smooth"].toVariant().toFloat());
     }
     if(json.contains("useAlpha")) {
-        m_useAlpha = json["useAlpha"].toBool();
+        setUseAlpha(json["useAlpha"].toBool());
     }
-    propertiesPanel->setProperty("startSides", m_sides);
-    propertiesPanel->setProperty("startScale", m_polygonScale);
-    propertiesPanel->setProperty("startSmooth", m_smooth);
-    propertiesPanel->setProperty("startUseAlpha", m_useAlpha);
 }
 
 int PolygonNode::sides() {
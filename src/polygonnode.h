@@ -57,6 +57,8 @@ public slots:
     void updatePolygonScale(qreal scale);
     void updateSmooth(qreal smooth);
     void updateUseAlpha(bool use);
+protected:
+    void setupPropertyPanel();
 private:
     PolygonObject *preview;
     int m_sides = 3;
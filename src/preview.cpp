@@ -20,6 +20,7 @@
  */
 
 #include "preview.h"
+#include "shaderwarmup.h"
 #include <iostream>
 #include <QOpenGLFramebufferObjectFormat>
 
@@ -113,14 +114,8 @@ unsigned int &PreviewObject::previewData() {
 
 PreviewRenderer::PreviewRenderer() {
     initializeOpenGLFunctions();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texmatrix.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
+    textureShader = createShaderProgram(PROGRAM_PREVIEW_TEXTURE);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
     textureShader->bind();
     textureShader->setUniformValue(textureShader->uniformLocation("textureSample"), 0);
     textureShader->release();
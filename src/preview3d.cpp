@@ -20,13 +20,49 @@
  */
 
 #include "preview3d.h"
+#include "shaderwarmup.h"
 #include <QOpenGLFramebufferObjectFormat>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
 #include <iostream>
 
+const quint32 iblCacheMagic = 0x5349424c;
+const quint32 iblCacheVersion = 1;
+const int irradianceSize = 32;
+const int prefilterSize = 128;
+const int prefilterLevels = 5;
+const int brdfSize = 512;
+
+QString iblCacheName(QString hdrFile) {
+    // keyed on where the map is and when it last changed, so a cache hit never reads the HDR
+    QFileInfo info(hdrFile);
+    if(!info.exists()) return QString();
+    QByteArray key = info.absoluteFilePath().toUtf8() + '|' + QByteArray::number(info.lastModified().toMSecsSinceEpoch()) +
+            '|' + QByteArray::number(info.size());
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return dir + "/ibl/" + QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex() + ".bin";
+}
+
+int cubemapDataSize(int size, int levels) {
+    int dataSize = 0;
+    for(int mip = 0; mip < levels; ++mip) {
+        dataSize += 6*3*sizeof(quint16)*(size >> mip)*(size >> mip);
+    }
+    return dataSize;
+}
+
 Preview3DObject::Preview3DObject(QQuickItem *parent): QQuickFramebufferObject (parent)
 {
     setAcceptedMouseButtons(Qt::AllButtons);
     //setMirrorVertically(true);
+    interactionTimer.setSingleShot(true);
+    interactionTimer.setInterval(200);
+    connect(&interactionTimer, &QTimer::timeout, this, &Preview3DObject::interactionFinished);
 }
 
 QQuickFramebufferObject::Renderer *Preview3DObject::createRenderer() const {
@@ -71,6 +107,7 @@ void Preview3DObject::mouseMoveEvent(QMouseEvent *event) {
         lastY = event->pos().y();
         lastWorldPos = worldPosNew;
         translationView = true;
+        beginInteraction();
         update();
     }
     else if(event->buttons() == Qt::MidButton) {
@@ -95,6 +132,7 @@ void Preview3DObject::mouseMoveEvent(QMouseEvent *event) {
         lastX = event->pos().x();
         lastY = event->pos().y();
         rotationObject = true;
+        beginInteraction();
         update();
     }
 }
@@ -111,6 +149,21 @@ void Preview3DObject::wheelEvent(QWheelEvent *event) {
     }
     m_zoomCam += stepZoom;
     zoomView = true;
+    beginInteraction();
+    update();
+}
+
+bool Preview3DObject::interactive() {
+    return m_interactive;
+}
+
+void Preview3DObject::beginInteraction() {
+    m_interactive = true;
+    interactionTimer.start();
+}
+
+void Preview3DObject::interactionFinished() {
+    m_interactive = false;
     update();
 }
 
@@ -160,6 +213,19 @@ unsigned int Preview3DObject::normal() {
     return m_normal;
 }
 
+QVariant Preview3DObject::height() {
+    return m_height;
+}
+
+float Preview3DObject::heightScale() {
+    return m_heightScale;
+}
+
+void Preview3DObject::setHeightScale(float scale) {
+    m_heightScale = scale;
+    update();
+}
+
 QVector2D Preview3DObject::texResolution() {
     return m_texResolution;
 }
@@ -197,56 +263,44 @@ void Preview3DObject::updateNormal(unsigned int normal) {
     update();
 }
 
+void Preview3DObject::updateHeight(QVariant height, bool useTexture) {
+    useHeightTex = useTexture;
+    m_height = height;
+    changedHeight = useTexture;
+    update();
+}
+
 Preview3DRenderer::Preview3DRenderer() {
     initializeOpenGLFunctions();
 
-    pbrShader = new QOpenGLShaderProgram();
-    pbrShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/pbr.vert");
-    pbrShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/pbr.frag");
-    pbrShader->link();
-
-    equirectangularShader = new QOpenGLShaderProgram();
-    equirectangularShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/cubemap.vert");
-    equirectangularShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/equirectangular.frag");
-    equirectangularShader->link();
-
-    irradianceShader = new QOpenGLShaderProgram();
-    irradianceShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/cubemap.vert");
-    irradianceShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/irradiance.frag");
-    irradianceShader->link();
-
-    prefilteredShader = new QOpenGLShaderProgram();
-    prefilteredShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/cubemap.vert");
-    prefilteredShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/prefiltered.frag");
-    prefilteredShader->link();
-
-    brdfShader = new QOpenGLShaderProgram();
-    brdfShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/brdf.vert");
-    brdfShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/brdf.frag");
-    brdfShader->link();
-
-    backgroundShader = new QOpenGLShaderProgram();
-    backgroundShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/background.vert");
-    backgroundShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/background.frag");
-    backgroundShader->link();
-
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/brdf.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
-
-    pbrShader->bind();
-    pbrShader->setUniformValue(pbrShader->uniformLocation("irradianceMap"), 0);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("prefilterMap"), 1);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("brdfLUT"), 2);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("albedoMap"), 3);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("normalMap"), 4);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("metallicMap"), 5);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("roughnessMap"), 6);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("albedoVal"), QVector3D(0.8f, 0.4f, 0.0f));
-    pbrShader->setUniformValue(pbrShader->uniformLocation("metallicVal"), 0.0f);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("roughnessVal"), 0.2f);
-    pbrShader->release();
+    pbrShader = createShaderProgram(PROGRAM_PBR);
+    pbrDisplaceShader = createShaderProgram(PROGRAM_PBR_DISPLACE);
+    tessellation = QOpenGLShader::hasOpenGLShaders(QOpenGLShader::TessellationControl | QOpenGLShader::TessellationEvaluation);
+    if(tessellation) {
+        pbrTessShader = createShaderProgram(PROGRAM_PBR_TESSELLATION);
+        tessellation = pbrTessShader->isLinked();
+    }
+
+    equirectangularShader = createShaderProgram(PROGRAM_EQUIRECTANGULAR);
+    irradianceShader = createShaderProgram(PROGRAM_IRRADIANCE);
+    prefilteredShader = createShaderProgram(PROGRAM_PREFILTERED);
+    brdfShader = createShaderProgram(PROGRAM_BRDF);
+    backgroundShader = createShaderProgram(PROGRAM_BACKGROUND);
+    textureShader = createShaderProgram(PROGRAM_QUAD_TEXTURE);
+
+    for(QOpenGLShaderProgram *shader: {pbrShader, pbrDisplaceShader, pbrTessShader}) {
+        if(!shader || !shader->isLinked()) continue;
+        shader->bind();
+        shader->setUniformValue(shader->uniformLocation("irradianceMap"), 0);
+        shader->setUniformValue(shader->uniformLocation("prefilterMap"), 1);
+        shader->setUniformValue(shader->uniformLocation("brdfLUT"), 2);
+        shader->setUniformValue(shader->uniformLocation("albedoMap"), 3);
+        shader->setUniformValue(shader->uniformLocation("normalMap"), 4);
+        shader->setUniformValue(shader->uniformLocation("metallicMap"), 5);
+        shader->setUniformValue(shader->uniformLocation("roughnessMap"), 6);
+        shader->setUniformValue(shader->uniformLocation("heightMap"), 7);
+        shader->release();
+    }
 
     backgroundShader->bind();
     backgroundShader->setUniformValue(backgroundShader->uniformLocation("environmentMap"), 0);
@@ -271,108 +325,24 @@ Preview3DRenderer::Preview3DRenderer() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
-    FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
-    FIBITMAP *dib(nullptr);
-    BYTE* bits(nullptr);
-    unsigned int width(0), height(0);
-    fif = FreeImage_GetFileType("hdr/Newport_Loft_Ref.hdr", 0);
-    if (fif == FIF_UNKNOWN) {
-        std::cout << "not get file type" << std::endl;
-    }
-    dib = FreeImage_Load(fif, "hdr/Newport_Loft_Ref.hdr");
-    if (!dib) {
-        std::cout << "not load image" << std::endl;
-    }
-    bits = FreeImage_GetBits(dib);
-    width = FreeImage_GetWidth(dib);
-    height = FreeImage_GetHeight(dib);
-    glGenTextures(1, &hdrTexture);
-    glBindTexture(GL_TEXTURE_2D, hdrTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, (void*)bits);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    FreeImage_Unload(dib);
-
-    QMatrix4x4 captureProjection;
-    captureProjection.perspective(90.0f, 1.0f, 0.1f, 10.0f);
-    QMatrix4x4 captureView[6];
-    captureView[0].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(1.0f, 0.0f, 0.0f), QVector3D(0.0f, -1.0f, 0.0f));
-    captureView[1].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(-1.0f, 0.0f, 0.0f), QVector3D(0.0f, -1.0f, 0.0f));
-    captureView[2].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 1.0f, 0.0f), QVector3D(0.0f, 0.0f, 1.0f));
-    captureView[3].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, -1.0f, 0.0f), QVector3D(0.0f, 0.0f, -1.0f));
-    captureView[4].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 0.0f, 1.0f), QVector3D(0.0f, -1.0f, 0.0f));
-    captureView[5].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 0.0f, -1.0f), QVector3D(0.0f, -1.0f, 0.0f));
-
-    glGenTextures(1, &envCubemap);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-    for (unsigned int i = 0; i < 6; ++i)
-    {
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 512, 512, 0, GL_RGB, GL_FLOAT, nullptr);
-    }
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    equirectangularShader->bind();
-    equirectangularShader->setUniformValue(equirectangularShader->uniformLocation("equirectangularMap"), 0);
-    equirectangularShader->setUniformValue(equirectangularShader->uniformLocation("projection"), captureProjection);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, hdrTexture);
-    glViewport(0, 0, 512, 512);
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-    for(unsigned int i = 0; i < 6; ++i) {
-        equirectangularShader->setUniformValue(equirectangularShader->uniformLocation("view"), captureView[i]);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, envCubemap, 0);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        renderCube();
-    }
-    equirectangularShader->release();
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-    glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-
-    //irradiance cubemap
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-    glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 32, 32);
     glGenTextures(1, &irradianceMap);
     glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
     for (unsigned int i = 0; i < 6; ++i)
     {
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 32, 32, 0, GL_RGB, GL_FLOAT, nullptr);
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, irradianceSize, irradianceSize, 0, GL_RGB, GL_FLOAT, nullptr);
     }
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    irradianceShader->bind();
-    irradianceShader->setUniformValue(irradianceShader->uniformLocation("projection"), captureProjection);
-    glActiveTexture(GL_TEXTURE0);
-    irradianceShader->setUniformValue(irradianceShader->uniformLocation("environmentMap"), 0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-    glViewport(0, 0, 32, 32);
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-    for(unsigned int i = 0; i < 6; ++i) {
-        irradianceShader->setUniformValue(irradianceShader->uniformLocation("view"), captureView[i]);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, irradianceMap, 0);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        renderCube();
-    }
-    irradianceShader->release();
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
     glGenTextures(1, &prefilterMap);
     glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
     for (unsigned int i = 0; i < 6; ++i)
     {
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 128, 128, 0, GL_RGB, GL_FLOAT, nullptr);
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, prefilterSize, prefilterSize, 0, GL_RGB, GL_FLOAT, nullptr);
     }
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -383,54 +353,21 @@ Preview3DRenderer::Preview3DRenderer() {
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 4);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LOD, 4);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-    unsigned int maxMipLevels = 5;
-    for(unsigned int mip = 0; mip < maxMipLevels; ++mip) {
-        unsigned int mipWidth = 128 * std::pow(0.5, mip);
-        unsigned int mipHeight = 128 * std::pow(0.5, mip);
-        prefilteredShader->bind();
-        prefilteredShader->setUniformValue(prefilteredShader->uniformLocation("environmentMap"), 0);
-        prefilteredShader->setUniformValue(prefilteredShader->uniformLocation("projection"), captureProjection);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-
-        glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
-        glViewport(0, 0, mipWidth, mipHeight);
-
-        float roughness = (float)mip / (float)(maxMipLevels - 1);
-        prefilteredShader->setUniformValue(prefilteredShader->uniformLocation("roughness"), roughness);
-        for(unsigned int i = 0; i < 6; ++i) {
-            prefilteredShader->setUniformValue(prefilteredShader->uniformLocation("view"), captureView[i]);
-            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, prefilterMap, mip);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            renderCube();
-        }
-        prefilteredShader->release();
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    }
     glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
-    glDisable(GL_BLEND);
     glGenTextures(1, &brdfLUTTexture);
     glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, 512, 512, 0, GL_RG, GL_FLOAT, nullptr);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, brdfSize, brdfSize, 0, GL_RG, GL_FLOAT, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-    glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, brdfLUTTexture, 0);
-    glViewport(0, 0, 512, 512);
-    brdfShader->bind();
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    renderQuad();
-    brdfShader->release();
     glBindTexture(GL_TEXTURE_2D, 0);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    glDisable(GL_BLEND);
+    QString hdrFile = "hdr/Newport_Loft_Ref.hdr";
+    QString cacheName = iblCacheName(hdrFile);
+    if(!loadIBLCache(cacheName)) bakeIBL(hdrFile, cacheName);
 
     glGenTextures(1, &albedoTexture);
     glBindTexture(GL_TEXTURE_2D, albedoTexture);
@@ -467,10 +404,25 @@ Preview3DRenderer::Preview3DRenderer() {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1024, 1024, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenTextures(1, &heightTexture);
+    glBindTexture(GL_TEXTURE_2D, heightTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1024, 1024, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &readFBO);
+    glGenFramebuffers(1, &drawFBO);
 }
 
 Preview3DRenderer::~Preview3DRenderer() {
+    delete interactionFBO;
     delete pbrShader;
+    delete pbrTessShader;
+    delete pbrDisplaceShader;
     delete irradianceShader;
     delete backgroundShader;
     delete equirectangularShader;
@@ -484,6 +436,7 @@ QOpenGLFramebufferObject *Preview3DRenderer::createFramebufferObject(const QSize
     format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
     format.setSamples(8);
     updateMatrix();
+    needsRender = true;
     return new QOpenGLFramebufferObject(size, format);
 }
 
@@ -491,81 +444,125 @@ void Preview3DRenderer::synchronize(QQuickFramebufferObject *item) {
     Preview3DObject *previewItem = static_cast<Preview3DObject*>(item);
     wWidth = previewItem->width();
     wHeight = previewItem->height();
-    primitive = previewItem->primitivesType();
+    if(primitive != previewItem->primitivesType()) {
+        primitive = previewItem->primitivesType();
+        needsRender = true;
+    }
+    if(interactive != previewItem->interactive()) {
+        interactive = previewItem->interactive();
+        needsRender = true;
+    }
     if(previewItem->translationView) {
         previewItem->translationView = false;
         positionV = previewItem->posCam();
         updateMatrix();
+        needsRender = true;
     }
     if(previewItem->zoomView) {
         previewItem->zoomView = false;
         zoom = previewItem->zoomCam();
         updateMatrix();
+        needsRender = true;
     }
     if(previewItem->rotationObject) {
         previewItem->rotationObject = false;
         rotQuat = previewItem->rotQuat();
         updateMatrix();
+        needsRender = true;
     }
     if(previewItem->updateRes) {
         previewItem->updateRes = false;
         m_texResolution = previewItem->texResolution();
         updateTexResolution();
+        needsRender = true;
     }
-    pbrShader->bind();
-    pbrShader->setUniformValue(pbrShader->uniformLocation("tilesSize"), previewItem->tilesSize());
-    pbrShader->setUniformValue(pbrShader->uniformLocation("useAlbMap"), previewItem->useAlbedoTex);
-    if(previewItem->useAlbedoTex) {
-        if(previewItem->changedAlbedo) {
-            previewItem->changedAlbedo = false;
-            updateOutputsTexture(albedoTexture, previewItem->albedo().toUInt());
-        }
-    }
-    else {
-        pbrShader->setUniformValue(pbrShader->uniformLocation("albedoVal"), qvariant_cast<QVector3D>(previewItem->albedo()));
-    }
-    pbrShader->setUniformValue(pbrShader->uniformLocation("useMetalMap"), previewItem->useMetalTex);
-    if(previewItem->useMetalTex) {
-        if(previewItem->changedMetal) {
-            previewItem->changedMetal = false;
-            updateOutputsTexture(metalTexture, previewItem->metalness().toUInt());
-        }
+    if(previewItem->changedAlbedo || previewItem->changedMetal || previewItem->changedRough ||
+       previewItem->changedNormal || previewItem->changedHeight || tilesSize != previewItem->tilesSize() ||
+       albedoValue != previewItem->albedo() || metalValue != previewItem->metalness() ||
+       roughValue != previewItem->roughness() || useHeightMap != previewItem->useHeightTex ||
+       heightScale != previewItem->heightScale()) {
+        tilesSize = previewItem->tilesSize();
+        albedoValue = previewItem->albedo();
+        metalValue = previewItem->metalness();
+        roughValue = previewItem->roughness();
+        heightScale = previewItem->heightScale();
+        needsRender = true;
     }
-    else {
-        pbrShader->setUniformValue(pbrShader->uniformLocation("metallicVal"), previewItem->metalness().toFloat());
+    useAlbedoMap = previewItem->useAlbedoTex;
+    if(previewItem->changedAlbedo) {
+        previewItem->changedAlbedo = false;
+        updateOutputsTexture(albedoTexture, previewItem->albedo().toUInt());
     }
-    pbrShader->setUniformValue(pbrShader->uniformLocation("useRoughMap"), previewItem->useRoughTex);
-    if(previewItem->useRoughTex) {
-        if(previewItem->changedRough) {
-            previewItem->changedRough = false;
-            updateOutputsTexture(roughTexture, previewItem->roughness().toUInt());
-        }
+    useMetalMap = previewItem->useMetalTex;
+    if(previewItem->changedMetal) {
+        previewItem->changedMetal = false;
+        updateOutputsTexture(metalTexture, previewItem->metalness().toUInt());
     }
-    else {
-        pbrShader->setUniformValue(pbrShader->uniformLocation("roughnessVal"), previewItem->roughness().toFloat());
+    useRoughMap = previewItem->useRoughTex;
+    if(previewItem->changedRough) {
+        previewItem->changedRough = false;
+        updateOutputsTexture(roughTexture, previewItem->roughness().toUInt());
     }
-
     if(previewItem->changedNormal) {
         previewItem->changedNormal = false;
         updateOutputsTexture(normalTexture, previewItem->normal());
     }
-    bool useNorm = previewItem->normal() ? true : false;
-    pbrShader->setUniformValue(pbrShader->uniformLocation("useNormMap"), useNorm);
-    pbrShader->release();
+    useNormalMap = previewItem->normal() ? true : false;
+    useHeightMap = previewItem->useHeightTex;
+    if(previewItem->changedHeight) {
+        previewItem->changedHeight = false;
+        updateOutputsTexture(heightTexture, previewItem->height().toUInt());
+    }
 }
 
 void Preview3DRenderer::render() {
+    if(!needsRender) return;
+    needsRender = false;
+    if(!interactive) {
+        renderScene();
+        return;
+    }
+    QOpenGLFramebufferObject *target = framebufferObject();
+    QSize size = (target->size()*interactionScale).expandedTo(QSize(1, 1));
+    if(!interactionFBO || interactionFBO->size() != size) {
+        delete interactionFBO;
+        interactionFBO = new QOpenGLFramebufferObject(size, QOpenGLFramebufferObject::Depth);
+        glBindTexture(GL_TEXTURE_2D, interactionFBO->texture());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    interactionFBO->bind();
+    glViewport(0, 0, size.width(), size.height());
+    renderScene();
+    target->bind();
+    glViewport(0, 0, target->width(), target->height());
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    textureShader->bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, interactionFBO->texture());
+    renderQuad();
+    glBindTexture(GL_TEXTURE_2D, 0);
+    textureShader->release();
+}
+
+void Preview3DRenderer::renderScene() {
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LEQUAL);
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
     glClearColor(0.227f, 0.235f, 0.243f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-    pbrShader->bind();
-    pbrShader->setUniformValue(pbrShader->uniformLocation("projection"), projection);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("view"), view);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("model"), model);
-    pbrShader->setUniformValue(pbrShader->uniformLocation("camPos"), -positionV);
+    bool displace = useHeightMap && heightScale != 0.0f;
+    QOpenGLShaderProgram *shader = pbrShader;
+    if(displace) shader = tessellation ? pbrTessShader : pbrDisplaceShader;
+    shader->bind();
+    shader->setUniformValue(shader->uniformLocation("projection"), projection);
+    shader->setUniformValue(shader->uniformLocation("view"), view);
+    shader->setUniformValue(shader->uniformLocation("model"), model);
+    shader->setUniformValue(shader->uniformLocation("camPos"), -positionV);
+    setMaterialUniforms(shader);
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
@@ -581,19 +578,26 @@ void Preview3DRenderer::render() {
     glBindTexture(GL_TEXTURE_2D, metalTexture);
     glActiveTexture(GL_TEXTURE6);
     glBindTexture(GL_TEXTURE_2D, roughTexture);
-    switch (primitive) {
-        case 0: default:
-            renderSphere();
-            break;
-        case 1:
-            renderCube();
-            break;
-        case 2:
-            renderPlane();
-            break;
+    glActiveTexture(GL_TEXTURE7);
+    glBindTexture(GL_TEXTURE_2D, heightTexture);
+    if(displace) {
+        renderDisplaced();
+    }
+    else {
+        switch (primitive) {
+            case 0: default:
+                renderSphere();
+                break;
+            case 1:
+                renderCube();
+                break;
+            case 2:
+                renderPlane();
+                break;
+        }
     }
 
-    pbrShader->release();
+    shader->release();
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -828,6 +832,138 @@ void Preview3DRenderer::renderPlane() {
     glBindVertexArray(0);
 }
 
+void Preview3DRenderer::renderDisplaced() {
+    int type = primitive == 1 || primitive == 2 ? primitive : 0;
+    if(tessellation) {
+        int viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        pbrTessShader->setUniformValue(pbrTessShader->uniformLocation("viewportSize"), QVector2D(viewport[2], viewport[3]));
+        pbrTessShader->setUniformValue(pbrTessShader->uniformLocation("spherical"), type == 0);
+        if(!patchVAO[type]) {
+            const int segments[3] = {64, 4, 8};
+            patchVAO[type] = createMesh(type, segments[type], patchCount[type]);
+        }
+        glPatchParameteri(GL_PATCH_VERTICES, 3);
+        glBindVertexArray(patchVAO[type]);
+        glDrawElements(GL_PATCHES, patchCount[type], GL_UNSIGNED_INT, 0);
+    }
+    else {
+        if(!denseVAO[type]) {
+            const int segments[3] = {256, 128, 256};
+            denseVAO[type] = createMesh(type, segments[type], denseCount[type]);
+        }
+        glBindVertexArray(denseVAO[type]);
+        glDrawElements(GL_TRIANGLES, denseCount[type], GL_UNSIGNED_INT, 0);
+    }
+    glBindVertexArray(0);
+}
+
+unsigned int Preview3DRenderer::createMesh(int type, int segments, unsigned int &count) {
+    std::vector<float> data;
+    std::vector<unsigned int> indices;
+    auto addVertex = [&data](QVector3D pos, QVector3D normal, QVector2D uv, QVector3D tangent, QVector3D bitangent) {
+        data.insert(data.end(), {pos.x(), pos.y(), pos.z(), normal.x(), normal.y(), normal.z(), uv.x(), uv.y(),
+                                 tangent.x(), tangent.y(), tangent.z(), bitangent.x(), bitangent.y(), bitangent.z()});
+    };
+    auto addGrid = [&indices, segments](unsigned int first) {
+        for(int y = 0; y < segments; ++y) {
+            for(int x = 0; x < segments; ++x) {
+                unsigned int i = first + y*(segments + 1) + x;
+                indices.insert(indices.end(), {i, i + segments + 1, i + 1, i + 1, i + segments + 1, i + segments + 2});
+            }
+        }
+    };
+
+    if(type == 0) {
+        // same parametrization as renderSphere, with dP/du and dP/dv for the height gradient
+        const float PI = 3.14159265359f;
+        for(int y = 0; y <= segments; ++y) {
+            for(int x = 0; x <= segments; ++x) {
+                float xSegment = (float)x/segments;
+                float ySegment = (float)y/segments;
+                float cosA = std::cos(xSegment*2.0f*PI), sinA = std::sin(xSegment*2.0f*PI);
+                float cosB = std::cos(ySegment*PI), sinB = std::sin(ySegment*PI);
+                QVector3D pos(cosA*sinB, cosB, sinA*sinB);
+                addVertex(pos, pos, QVector2D(2.0f - xSegment*2, 1.0f - ySegment),
+                          QVector3D(sinA*sinB, 0.0f, -cosA*sinB)*PI,
+                          QVector3D(-cosA*cosB, sinB, -sinA*cosB)*PI);
+            }
+        }
+        addGrid(0);
+    }
+    else {
+        // cube faces use the same uv layout as renderCube, the plane matches renderPlane
+        struct Face { QVector3D normal, axisU, axisV; };
+        std::vector<Face> faces;
+        if(type == 1) {
+            faces = {{QVector3D(0, 0, -1), QVector3D(-1, 0, 0), QVector3D(0, 1, 0)},
+                     {QVector3D(0, 0, 1), QVector3D(1, 0, 0), QVector3D(0, 1, 0)},
+                     {QVector3D(-1, 0, 0), QVector3D(0, 0, 1), QVector3D(0, 1, 0)},
+                     {QVector3D(1, 0, 0), QVector3D(0, 0, -1), QVector3D(0, 1, 0)},
+                     {QVector3D(0, -1, 0), QVector3D(1, 0, 0), QVector3D(0, 0, -1)},
+                     {QVector3D(0, 1, 0), QVector3D(1, 0, 0), QVector3D(0, 0, -1)}};
+        }
+        else {
+            faces = {{QVector3D(0, 0, 0), QVector3D(1, 0, 0), QVector3D(0, 1, 0)}};
+        }
+        for(const Face &face: faces) {
+            unsigned int first = data.size()/14;
+            QVector3D normal = type == 1 ? face.normal : QVector3D(0, 0, 1);
+            for(int y = 0; y <= segments; ++y) {
+                for(int x = 0; x <= segments; ++x) {
+                    QVector2D uv((float)x/segments, (float)y/segments);
+                    QVector3D pos = face.normal + face.axisU*(2*uv.x() - 1) + face.axisV*(2*uv.y() - 1);
+                    addVertex(pos, normal, uv, face.axisU*2, face.axisV*2);
+                }
+            }
+            addGrid(first);
+        }
+    }
+    count = indices.size();
+
+    unsigned int vao, vbo, ebo;
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, data.size()*sizeof(float), data.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size()*sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    int stride = 14*sizeof(float);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)(11 * sizeof(float)));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return vao;
+}
+
+void Preview3DRenderer::setMaterialUniforms(QOpenGLShaderProgram *shader) {
+    shader->setUniformValue(shader->uniformLocation("tilesSize"), tilesSize);
+    shader->setUniformValue(shader->uniformLocation("useAlbMap"), useAlbedoMap);
+    if(!useAlbedoMap) {
+        shader->setUniformValue(shader->uniformLocation("albedoVal"), qvariant_cast<QVector3D>(albedoValue));
+    }
+    shader->setUniformValue(shader->uniformLocation("useMetalMap"), useMetalMap);
+    if(!useMetalMap) {
+        shader->setUniformValue(shader->uniformLocation("metallicVal"), metalValue.toFloat());
+    }
+    shader->setUniformValue(shader->uniformLocation("useRoughMap"), useRoughMap);
+    if(!useRoughMap) {
+        shader->setUniformValue(shader->uniformLocation("roughnessVal"), roughValue.toFloat());
+    }
+    shader->setUniformValue(shader->uniformLocation("useNormMap"), useNormalMap);
+    shader->setUniformValue(shader->uniformLocation("heightScale"), heightScale);
+}
+
 void Preview3DRenderer::updateMatrix() {
     projection = QMatrix4x4();
     projection.perspective(zoom, (float)wWidth/(float)wHeight, 0.1f, 38.0f);
@@ -847,16 +983,244 @@ void Preview3DRenderer::updateTexResolution() {
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_texResolution.x(), m_texResolution.y(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glBindTexture(GL_TEXTURE_2D, normalTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_texResolution.x(), m_texResolution.y(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, heightTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_texResolution.x(), m_texResolution.y(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void Preview3DRenderer::updateOutputsTexture(unsigned int &dst, const unsigned int &src) {
+    if(!src) {
+        // a disconnected map must not keep showing the last one that was copied
+        glClearTexImage(dst, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindTexture(GL_TEXTURE_2D, dst);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return;
+    }
+    int width, height, format;
     glBindTexture(GL_TEXTURE_2D, src);
-    GLubyte *pixels = new GLubyte[m_texResolution.x()*m_texResolution.y()*4];
-    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if(format == GL_RGBA8 && width == m_texResolution.x() && height == m_texResolution.y()) {
+        glCopyImageSubData(src, GL_TEXTURE_2D, 0, 0, 0, 0, dst, GL_TEXTURE_2D, 0, 0, 0, 0, width, height, 1);
+    }
+    else {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, src, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFBO);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, dst, 0);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, m_texResolution.x(), m_texResolution.y(), GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
     glBindTexture(GL_TEXTURE_2D, dst);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_texResolution.x(), m_texResolution.y(), 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
     glGenerateMipmap(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, 0);
-    delete [] pixels;
+}
+
+QByteArray Preview3DRenderer::cubemapData(unsigned int texture, int size, int levels) {
+    QByteArray data(cubemapDataSize(size, levels), 0);
+    char *pixels = data.data();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    for(int mip = 0; mip < levels; ++mip) {
+        int mipSize = size >> mip;
+        for(unsigned int i = 0; i < 6; ++i) {
+            glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, GL_RGB, GL_HALF_FLOAT, pixels);
+            pixels += 3*sizeof(quint16)*mipSize*mipSize;
+        }
+    }
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    return data;
+}
+
+void Preview3DRenderer::uploadCubemap(unsigned int texture, int size, int levels, const QByteArray &data) {
+    const char *pixels = data.constData();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    for(int mip = 0; mip < levels; ++mip) {
+        int mipSize = size >> mip;
+        for(unsigned int i = 0; i < 6; ++i) {
+            glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, 0, 0, mipSize, mipSize, GL_RGB, GL_HALF_FLOAT, pixels);
+            pixels += 3*sizeof(quint16)*mipSize*mipSize;
+        }
+    }
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+bool Preview3DRenderer::loadIBLCache(QString fileName) {
+    if(fileName.isEmpty()) return false;
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly)) return false;
+    QDataStream stream(&file);
+    quint32 magic, version;
+    stream >> magic >> version;
+    if(magic != iblCacheMagic || version != iblCacheVersion) return false;
+    QByteArray irradiance, prefilter, brdf;
+    stream >> irradiance >> prefilter >> brdf;
+    if(stream.status() != QDataStream::Ok ||
+       irradiance.size() != cubemapDataSize(irradianceSize, 1) ||
+       prefilter.size() != cubemapDataSize(prefilterSize, prefilterLevels) ||
+       brdf.size() != int(2*sizeof(quint16)*brdfSize*brdfSize)) {
+        return false;
+    }
+    uploadCubemap(irradianceMap, irradianceSize, 1, irradiance);
+    uploadCubemap(prefilterMap, prefilterSize, prefilterLevels, prefilter);
+    glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, brdfSize, brdfSize, GL_RG, GL_HALF_FLOAT, brdf.constData());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+void Preview3DRenderer::saveIBLCache(QString fileName) {
+    if(fileName.isEmpty()) return;
+    QByteArray irradiance = cubemapData(irradianceMap, irradianceSize, 1);
+    QByteArray prefilter = cubemapData(prefilterMap, prefilterSize, prefilterLevels);
+    QByteArray brdf(2*sizeof(quint16)*brdfSize*brdfSize, 0);
+    glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RG, GL_HALF_FLOAT, brdf.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    QDir().mkpath(QFileInfo(fileName).path());
+    QSaveFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly)) return;
+    QDataStream stream(&file);
+    stream << iblCacheMagic << iblCacheVersion << irradiance << prefilter << brdf;
+    file.commit();
+}
+
+void Preview3DRenderer::bakeIBL(QString hdrFile, QString cacheName) {
+    FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
+    FIBITMAP *dib(nullptr);
+    BYTE* bits(nullptr);
+    unsigned int width(0), height(0);
+    fif = FreeImage_GetFileType(qPrintable(hdrFile), 0);
+    if (fif == FIF_UNKNOWN) {
+        qWarning("Couldn`t get the environment map file type.");
+        return;
+    }
+    dib = FreeImage_Load(fif, qPrintable(hdrFile));
+    if (!dib) {
+        qWarning("Couldn`t load the environment map.");
+        return;
+    }
+    bits = FreeImage_GetBits(dib);
+    width = FreeImage_GetWidth(dib);
+    height = FreeImage_GetHeight(dib);
+    glGenTextures(1, &hdrTexture);
+    glBindTexture(GL_TEXTURE_2D, hdrTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, (void*)bits);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    FreeImage_Unload(dib);
+
+    QMatrix4x4 captureProjection;
+    captureProjection.perspective(90.0f, 1.0f, 0.1f, 10.0f);
+    QMatrix4x4 captureView[6];
+    captureView[0].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(1.0f, 0.0f, 0.0f), QVector3D(0.0f, -1.0f, 0.0f));
+    captureView[1].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(-1.0f, 0.0f, 0.0f), QVector3D(0.0f, -1.0f, 0.0f));
+    captureView[2].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 1.0f, 0.0f), QVector3D(0.0f, 0.0f, 1.0f));
+    captureView[3].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, -1.0f, 0.0f), QVector3D(0.0f, 0.0f, -1.0f));
+    captureView[4].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 0.0f, 1.0f), QVector3D(0.0f, -1.0f, 0.0f));
+    captureView[5].lookAt(QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 0.0f, -1.0f), QVector3D(0.0f, -1.0f, 0.0f));
+
+    glGenTextures(1, &envCubemap);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 512, 512, 0, GL_RGB, GL_FLOAT, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    equirectangularShader->bind();
+    equirectangularShader->setUniformValue(equirectangularShader->uniformLocation("equirectangularMap"), 0);
+    equirectangularShader->setUniformValue(equirectangularShader->uniformLocation("projection"), captureProjection);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, hdrTexture);
+    glViewport(0, 0, 512, 512);
+    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    for(unsigned int i = 0; i < 6; ++i) {
+        equirectangularShader->setUniformValue(equirectangularShader->uniformLocation("view"), captureView[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, envCubemap, 0);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        renderCube();
+    }
+    equirectangularShader->release();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+    glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    //irradiance cubemap
+    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, irradianceSize, irradianceSize);
+    irradianceShader->bind();
+    irradianceShader->setUniformValue(irradianceShader->uniformLocation("projection"), captureProjection);
+    glActiveTexture(GL_TEXTURE0);
+    irradianceShader->setUniformValue(irradianceShader->uniformLocation("environmentMap"), 0);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+    glViewport(0, 0, irradianceSize, irradianceSize);
+    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    for(unsigned int i = 0; i < 6; ++i) {
+        irradianceShader->setUniformValue(irradianceShader->uniformLocation("view"), captureView[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, irradianceMap, 0);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        renderCube();
+    }
+    irradianceShader->release();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    unsigned int maxMipLevels = prefilterLevels;
+    for(unsigned int mip = 0; mip < maxMipLevels; ++mip) {
+        unsigned int mipWidth = prefilterSize * std::pow(0.5, mip);
+        unsigned int mipHeight = prefilterSize * std::pow(0.5, mip);
+        prefilteredShader->bind();
+        prefilteredShader->setUniformValue(prefilteredShader->uniformLocation("environmentMap"), 0);
+        prefilteredShader->setUniformValue(prefilteredShader->uniformLocation("projection"), captureProjection);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
+        glViewport(0, 0, mipWidth, mipHeight);
+
+        float roughness = (float)mip / (float)(maxMipLevels - 1);
+        prefilteredShader->setUniformValue(prefilteredShader->uniformLocation("roughness"), roughness);
+        for(unsigned int i = 0; i < 6; ++i) {
+            prefilteredShader->setUniformValue(prefilteredShader->uniformLocation("view"), captureView[i]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, prefilterMap, mip);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            renderCube();
+        }
+        prefilteredShader->release();
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, brdfSize, brdfSize);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, brdfLUTTexture, 0);
+    glViewport(0, 0, brdfSize, brdfSize);
+    brdfShader->bind();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    renderQuad();
+    brdfShader->release();
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    saveIBLCache(cacheName);
 }
@@ -24,6 +24,8 @@
 #include <QQuickFramebufferObject>
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
+#include <QOpenGLFramebufferObject>
+#include <QTimer>
 #include "FreeImage.h"
 
 class Preview3DObject: public QQuickFramebufferObject
@@ -36,6 +38,7 @@ public:
     void mousePressEvent(QMouseEvent *event);
     void mouseMoveEvent(QMouseEvent *event);
     void wheelEvent(QWheelEvent *event);
+    bool interactive();
     QVector3D posCam();
     float zoomCam();
     QQuaternion rotQuat();
@@ -47,6 +50,8 @@ public:
     QVariant metalness();
     QVariant roughness();
     unsigned int normal();
+    QVariant height();
+    float heightScale();
     QVector2D texResolution();
     void setTexResolution(QVector2D res);
     bool translationView = false;
@@ -56,16 +61,22 @@ public:
     bool useAlbedoTex = false;
     bool useMetalTex = false;
     bool useRoughTex = false;
+    bool useHeightTex = false;
     bool changedAlbedo = false;
     bool changedRough = false;
     bool changedMetal = false;
     bool changedNormal = false;
+    bool changedHeight = false;
 public slots:
     void updateAlbedo(QVariant albedo, bool useTexture);
     void updateMetal(QVariant metal, bool useTexture);
     void updateRough(QVariant rough, bool useTexture);
     void updateNormal(unsigned int normal);
+    void updateHeight(QVariant height, bool useTexture);
+    void setHeightScale(float scale);
+    void interactionFinished();
 private:
+    void beginInteraction();
     float lastX = 0.0f;
     float lastY = 0.0f;
     float theta = 0.0f;
@@ -78,9 +89,13 @@ private:
     QVariant m_metalness = 0.0f;
     QVariant m_roughness = 0.2f;
     unsigned int m_normal = 0;
+    QVariant m_height = 0.0f;
+    float m_heightScale = 0.1f;
     QVector2D m_texResolution = QVector2D(1024, 1024);
     int m_primitive = 0;
     int m_tile = 1;
+    bool m_interactive = false;
+    QTimer interactionTimer;
 };
 
 class Preview3DRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
@@ -92,6 +107,8 @@ public:
     void render();
 private:
     QOpenGLShaderProgram *pbrShader;
+    QOpenGLShaderProgram *pbrTessShader = nullptr;
+    QOpenGLShaderProgram *pbrDisplaceShader;
     QOpenGLShaderProgram *equirectangularShader;
     QOpenGLShaderProgram *irradianceShader;
     QOpenGLShaderProgram *prefilteredShader;
@@ -111,6 +128,11 @@ private:
     unsigned int cubeVAO = 0;
     unsigned int quadVAO = 0;
     unsigned int planeVAO = 0;
+    unsigned int patchVAO[3] = {0, 0, 0};
+    unsigned int patchCount[3] = {0, 0, 0};
+    unsigned int denseVAO[3] = {0, 0, 0};
+    unsigned int denseCount[3] = {0, 0, 0};
+    bool tessellation = false;
     unsigned int indexCount;
     unsigned int wWidth, wHeight;
     QVector3D positionV = QVector3D(0.0f, 0.0f, -19.0f);
@@ -121,14 +143,40 @@ private:
     unsigned int metalTexture = 0;
     unsigned int roughTexture = 0;
     unsigned int normalTexture = 0;
+    unsigned int heightTexture = 0;
+    unsigned int readFBO = 0;
+    unsigned int drawFBO = 0;
+    QOpenGLFramebufferObject *interactionFBO = nullptr;
+    const float interactionScale = 0.5f;
+    bool interactive = false;
+    bool needsRender = true;
+    int tilesSize = 1;
+    QVariant albedoValue;
+    QVariant metalValue;
+    QVariant roughValue;
+    bool useAlbedoMap = false;
+    bool useMetalMap = false;
+    bool useRoughMap = false;
+    bool useNormalMap = false;
+    bool useHeightMap = false;
+    float heightScale = 0.1f;
 
+    void renderScene();
     void renderCube();
     void renderQuad();
     void renderSphere();
     void renderPlane();
+    void renderDisplaced();
+    unsigned int createMesh(int type, int segments, unsigned int &count);
+    void setMaterialUniforms(QOpenGLShaderProgram *shader);
     void updateMatrix();
     void updateTexResolution();
     void updateOutputsTexture(unsigned int &dst, const unsigned int &src);
+    QByteArray cubemapData(unsigned int texture, int size, int levels);
+    void uploadCubemap(unsigned int texture, int size, int levels, const QByteArray &data);
+    bool loadIBLCache(QString fileName);
+    void saveIBLCache(QString fileName);
+    void bakeIBL(QString hdrFile, QString cacheName);
 };
 
 #endif // PREVIEW3D_H
@@ -39,17 +39,18 @@ RoughNode::RoughNode(QQuickItem *parent, QVector2D resolution): Node(parent, res
     connect(preview, &OneChanelObject::updatePreview, this, &RoughNode::updatePreview);
     connect(preview, &OneChanelObject::updateValue, this, &RoughNode::roughChanged);
     connect(this, &Node::changeResolution, preview, &OneChanelObject::setResolution);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/RoughProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    connect(propertiesPanel, SIGNAL(roughChanged(qreal)), this, SLOT(updateRough(qreal)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/RoughProperty.qml"));
 }
 
 RoughNode::~RoughNode() {
     delete preview;
 }
 
+void RoughNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startRough", m_rough);
+    connect(propertiesPanel, SIGNAL(roughChanged(qreal)), this, SLOT(updateRough(qreal)));
+}
+
 void RoughNode::operation() {
     if(m_socketsInput[0]->countEdge() > 0) {
         preview->setValue(m_socketsInput[0]->value());
@@ -81,14 +82,13 @@ void RoughNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash
     Node::deserialize(json, hash);
     if(json.contains("rough")) {
         updateRough(json["rough"].toVariant().toFloat());
-        propertiesPanel->setProperty("startRough", m_rough);
     }
 }
 
 void RoughNode::updateRough(qreal rough) {
     m_rough = rough;
     if(m_socketsInput[0]->countEdge() == 0) {
-        operation();
+        requestOperation();
     }
     dataChanged();
 }
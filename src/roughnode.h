@@ -42,6 +42,8 @@ public slots:
     void saveRough(QString dir);
 signals:
     void roughChanged(QVariant rough, bool useTexture);
+protected:
+    void setupPropertyPanel();
 private:
     OneChanelObject *preview;
     float m_rough = 0.2f;
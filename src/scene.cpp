@@ -43,27 +43,62 @@
 #include "mirrornode.h"
 #include "brightnesscontrastnode.h"
 #include "thresholdnode.h"
+#include "heightnode.h"
 #include <QtWidgets/QFileDialog>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <functional>
+
+const float viewportMargin = 200.0f;
+const float placeholderScale = 0.35f;
+const int loadProgressStep = 64;
+const int sceneFormatVersion = 2;
+const int undoLimit = 256;
+const int outputCacheBudget = 512*1024*1024;
+const int saveTimeout = 5000;
+const int maxOutputSide = 16384;
+const QByteArray cborSignature("\xd9\xd9\xf7");
 
 Scene::Scene(QQuickItem *parent, QVector2D resolution): QQuickItem (parent), m_resolution(resolution)
 {
     setAcceptedMouseButtons(Qt::AllButtons);
     m_background = new BackgroundObject(this);
+    m_canvas = new QQuickItem(this);
+    connect(m_background, &BackgroundObject::panChanged, this, &Scene::updateCanvasPan);
+    connect(m_background, &BackgroundObject::scaleChanged, this, &QQuickItem::polish);
+    connect(this, &QQuickItem::widthChanged, this, &QQuickItem::polish);
+    connect(this, &QQuickItem::heightChanged, this, &QQuickItem::polish);
+    m_edgeBatch = new EdgeBatch(m_canvas);
+    connect(m_background, &BackgroundObject::scaleChanged, m_edgeBatch, &EdgeBatch::updateScale);
     m_preview3d = new Preview3DObject();
     m_undoStack = new QUndoStack(this);
-    m_undoStack->setUndoLimit(32);   
-    rectView = new QQuickView();
+    m_undoStack->setUndoLimit(undoLimit);
+    m_outputCache.setMaxCost(outputCacheBudget);
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(saveTimeout);
+    connect(&m_saveTimer, &QTimer::timeout, this, &Scene::saveTimedOut);
     setClip(true);
     connect(this, &Scene::resolutionUpdate, m_preview3d, &Preview3DObject::setTexResolution);
 }
 
 Scene::~Scene() {
+    if(!m_savingNodes.isEmpty()) {
+        // a save still waiting for outputs is written with what has been captured so far
+        blockSignals(true);
+        m_savingNodes.clear();
+        writeBinaryScene();
+        blockSignals(false);
+    }
     startSocket = nullptr;
     dragEdge = nullptr;
     cutLine = nullptr;
     m_selectedItem.clear();
     if(rectSelect) delete rectSelect;
-    if(rectView) delete rectView;
     if(cutLine) delete cutLine;
     for(Node *node: m_nodes) {
         delete node;
@@ -83,6 +118,7 @@ Scene::~Scene() {
     delete m_background;
     delete m_undoStack;
     delete m_preview3d;
+    qDeleteAll(m_sceneFiles);
 }
 
 QList<Node *> Scene::nodes() const {
@@ -90,7 +126,13 @@ QList<Node *> Scene::nodes() const {
 }
 
 void Scene::setNodes(const QList<Node *> &nodes) {
+    for(auto n: m_nodes) {
+        unindexItem(n);
+    }
     m_nodes = nodes;
+    for(auto n: m_nodes) {
+        indexItem(n);
+    }
 }
 
 QList<Edge *> Scene::edges() const {
@@ -98,7 +140,14 @@ QList<Edge *> Scene::edges() const {
 }
 
 void Scene::setEdges(const QList<Edge *> &edges) {
+    for(auto e: m_edges) {
+        unindexItem(e);
+    }
     m_edges = edges;
+    for(auto e: m_edges) {
+        indexItem(e);
+    }
+    edgesChanged();
 }
 
 BackgroundObject *Scene::background() const {
@@ -109,6 +158,21 @@ Preview3DObject *Scene::preview3d() const {
     return m_preview3d;
 }
 
+EdgeBatch *Scene::edgeBatch() const {
+    return m_edgeBatch;
+}
+
+QQuickItem *Scene::canvas() const {
+    return m_canvas;
+}
+
+Scene *Scene::sceneOf(QQuickItem *item) {
+    while(item && !qobject_cast<Scene*>(item)) {
+        item = item->parentItem();
+    }
+    return qobject_cast<Scene*>(item);
+}
+
 bool Scene::addSelected(QQuickItem *item) {
     if(m_selectedItem.contains(item)) return false;
     m_selectedItem.push_back(item);
@@ -209,6 +273,10 @@ void Scene::deleteNode(Node *node) {
         activeNodeChanged();
     }
     m_nodes.removeOne(node);
+    unindexItem(node);
+    m_detailedNodes.remove(node);
+    m_deferredNodes.remove(node);
+    node->setDetail(CULLED);
     if(qobject_cast<AlbedoNode*>(node)) {
         AlbedoNode * albedoNode = qobject_cast<AlbedoNode*>(node);
         disconnect(albedoNode, &AlbedoNode::albedoChanged, m_preview3d, &Preview3DObject::updateAlbedo);
@@ -237,9 +305,23 @@ void Scene::deleteNode(Node *node) {
         m_normalConnected = false;
         m_preview3d->updateNormal(0);
     }
+    else if(qobject_cast<HeightNode*>(node)) {
+        HeightNode *heightNode = qobject_cast<HeightNode*>(node);
+        disconnect(heightNode, &HeightNode::heightChanged, m_preview3d, &Preview3DObject::updateHeight);
+        disconnect(heightNode, &HeightNode::heightScaleChanged, m_preview3d, &Preview3DObject::setHeightScale);
+        disconnect(this, &Scene::outputsSave, heightNode, &HeightNode::saveHeight);
+        m_heightConnected = false;
+        m_preview3d->updateHeight(0.0f, false);
+    }
     disconnect(node, &Node::dataChanged, this, &Scene::nodeDataChanged);
+    disconnect(node, &Node::outputCaptured, this, &Scene::nodeOutputCaptured);
+    m_awaitedOutputs.remove(node);
+    m_retainingNodes.remove(node);
+    m_restoredHashes.remove(node);
+    m_outputHashes.remove(node);
+    edgesChanged();
+    if(m_savingNodes.remove(node) && m_savingNodes.isEmpty()) writeBinaryScene();
     disconnect(m_background, &BackgroundObject::scaleChanged, node, &Node::scaleUpdate);
-    disconnect(m_background, &BackgroundObject::panChanged, node, &Node::setPan);
     if(!m_modified) {
         m_modified = true;
         fileNameUpdate(m_fileName, m_modified);
@@ -273,12 +355,22 @@ void Scene::addNode(Node *node) {
         connect(this, &Scene::outputsSave, normNode, &NormalNode::saveNormal);
         m_normalConnected = true;
     }
+    else if(qobject_cast<HeightNode*>(node)) {
+        HeightNode *heightNode = qobject_cast<HeightNode*>(node);
+        connect(heightNode, &HeightNode::heightChanged, m_preview3d, &Preview3DObject::updateHeight);
+        connect(heightNode, &HeightNode::heightScaleChanged, m_preview3d, &Preview3DObject::setHeightScale);
+        connect(this, &Scene::outputsSave, heightNode, &HeightNode::saveHeight);
+        m_heightConnected = true;
+        m_preview3d->setHeightScale(heightNode->heightScale());
+    }
     connect(node, &Node::dataChanged, this, &Scene::nodeDataChanged);
+    connect(node, &Node::outputCaptured, this, &Scene::nodeOutputCaptured);
     connect(this, &Scene::resolutionUpdate, node, &Node::setResolution);
     connect(m_background, &BackgroundObject::scaleChanged, node, &Node::scaleUpdate);
-    connect(m_background, &BackgroundObject::panChanged, node, &Node::setPan);
+    node->setParentItem(m_canvas);
     node->scaleUpdate(m_background->viewScale());
-    node->setPan(m_background->viewPan());
+    indexItem(node);
+    polish();
     if(!m_modified) {
         m_modified = true;
         fileNameUpdate(m_fileName, m_modified);
@@ -287,8 +379,12 @@ void Scene::addNode(Node *node) {
 }
 
 Node *Scene::nodeAt(float x, float y) {
-    for(Node *node: m_nodes) {
-        if(node->x() <= x && node->x() + node->width() >= x && node->y() <= y && node->y() + node->height() >= y) {
+    updateBounds();
+    QPointF point = m_canvas->mapFromItem(this, QPointF(x, y));
+    QList<QQuickItem*> nodes = m_nodesIndex.query(canvasToWorld(QRectF(point, QSizeF())));
+    for(int i = nodes.size() - 1; i >= 0; --i) {
+        Node *node = static_cast<Node*>(nodes[i]);
+        if(node->x() <= point.x() && node->x() + node->width() >= point.x() && node->y() <= point.y() && node->y() + node->height() >= point.y()) {
             return node;
         }
     }
@@ -296,6 +392,8 @@ Node *Scene::nodeAt(float x, float y) {
 }
 
 void Scene::nodeDataChanged() {
+    Node *node = qobject_cast<Node*>(sender());
+    if(node) invalidateOutputHash(node);
     if(!m_modified) {
         m_modified = true;
         fileNameUpdate(m_fileName, m_modified);
@@ -304,6 +402,8 @@ void Scene::nodeDataChanged() {
 
 void Scene::deleteEdge(Edge *edge) {
     m_edges.removeOne(edge);
+    edgesChanged();
+    unindexItem(edge);
     if(!m_modified) {
         m_modified = true;
         fileNameUpdate(m_fileName, m_modified);
@@ -313,6 +413,9 @@ void Scene::deleteEdge(Edge *edge) {
 void Scene::addEdge(Edge *edge) {
     if(m_edges.contains(edge)) return;
     m_edges.append(edge);
+    edgesChanged();
+    edge->setParentItem(m_canvas);
+    indexItem(edge);
     if(!m_modified) {
         m_modified = true;
         fileNameUpdate(m_fileName, m_modified);
@@ -321,7 +424,7 @@ void Scene::addEdge(Edge *edge) {
 
 void Scene::deleteFrame(Frame *frame) {
     m_frames.removeOne(frame);
-    disconnect(m_background, &BackgroundObject::panChanged, frame, &Frame::setPan);
+    unindexItem(frame);
     disconnect(m_background, &BackgroundObject::scaleChanged, frame, &Frame::setScaleView);
     if(!m_modified) {
         m_modified = true;
@@ -332,10 +435,10 @@ void Scene::deleteFrame(Frame *frame) {
 void Scene::addFrame(Frame *frame) {
     if(m_frames.contains(frame)) return;
     m_frames.insert(0, frame);
-    connect(m_background, &BackgroundObject::panChanged, frame, &Frame::setPan);
     connect(m_background, &BackgroundObject::scaleChanged, frame, &Frame::setScaleView);
+    frame->setParentItem(m_canvas);
     frame->setScaleView(m_background->viewScale());
-    frame->setPan(m_background->viewPan());
+    indexItem(frame);
     if(!m_modified) {
         m_modified = true;
         fileNameUpdate(m_fileName, m_modified);
@@ -343,9 +446,15 @@ void Scene::addFrame(Frame *frame) {
 }
 
 Frame *Scene::frameAt(float x, float y) {
-    for(Frame *frame: m_frames) {
+    updateBounds();
+    QPointF point = m_canvas->mapFromItem(this, QPointF(x, y));
+    QList<QQuickItem*> frames = m_framesIndex.query(canvasToWorld(QRectF(point, QSizeF())));
+    // query() returns frames in insertion order, addFrame() puts new frames first in m_frames,
+    // so the newest frame under the point wins and nested frames stay reachable
+    for(int i = frames.size() - 1; i >= 0; --i) {
+        Frame *frame = static_cast<Frame*>(frames[i]);
         if(frame->selected()) continue;
-        if((frame->x() <= x && frame->x() + frame->width() >= x) && (frame->y() <= y && frame->y() + frame->height() >= y)){
+        if((frame->x() <= point.x() && frame->x() + frame->width() >= point.x()) && (frame->y() <= point.y() && frame->y() + frame->height() >= point.y())){
             return frame;
         }
     }
@@ -393,10 +502,8 @@ void Scene::mouseMoveEvent(QMouseEvent *event) {
     }
     else if(event->buttons() == Qt::LeftButton) {
         if(!rectSelect) {
-           // rectView = new QQuickView();
-            rectView->setSource(QUrl(QStringLiteral("qrc:/qml/RectSelection.qml")));
-            rectSelect = qobject_cast<QQuickItem*>(rectView->rootObject());
-            rectSelect->setParentItem(this);
+            rectSelect = createItem(QUrl(QStringLiteral("qrc:/qml/RectSelection.qml")), this);
+            if(!rectSelect) return;
             rectSelect->setProperty("rotCenterX", event->pos().x());
             rectSelect->setProperty("rotCenterY", event->pos().y());
             rectSelect->setX(event->pos().x());
@@ -419,19 +526,26 @@ void Scene::mouseMoveEvent(QMouseEvent *event) {
         rectSelect->setWidth(abs(difX));
         rectSelect->setHeight(abs(difY));
 
-        for(auto n: m_nodes) {
-            if(rectSelect->x() + rectSelect->width() < n->x() + 6 || rectSelect->x() > n->x() + n->width() - 6 ||
-               rectSelect->y() + rectSelect->height() < n->y() || rectSelect->y() > n->y() + n->height()) {
-                if(n->selected()) {
-                    n->setSelected(false);
-                    m_selectedItem.removeOne(n);
-                }
+        updateBounds();
+        QRectF area = m_canvas->mapRectFromItem(this, QRectF(rectSelect->x(), rectSelect->y(), rectSelect->width(), rectSelect->height()));
+        QSet<QQuickItem*> inside;
+        for(QQuickItem *item: m_nodesIndex.query(canvasToWorld(area))) {
+            Node *n = static_cast<Node*>(item);
+            if(area.right() < n->x() + 6 || area.left() > n->x() + n->width() - 6 ||
+               area.bottom() < n->y() || area.top() > n->y() + n->height()) {
+                continue;
             }
-            else {
-                if(!n->selected()) {
-                    n->setSelected(true);
-                    m_selectedItem.push_back(n);
-                }
+            inside.insert(n);
+            if(!n->selected()) {
+                n->setSelected(true);
+                m_selectedItem.push_back(n);
+            }
+        }
+        for(QQuickItem *item: QList<QQuickItem*>(m_selectedItem)) {
+            Node *n = qobject_cast<Node*>(item);
+            if(n && !inside.contains(n)) {
+                n->setSelected(false);
+                m_selectedItem.removeOne(n);
             }
         }
     }
@@ -440,20 +554,20 @@ void Scene::mouseMoveEvent(QMouseEvent *event) {
 void Scene::mouseReleaseEvent(QMouseEvent *event) {
     if(rectSelect) {
         delete rectSelect;
-        //delete rectView;
         rectSelect = nullptr;
-        //rectView = nullptr;
         selectedItems(QList<QQuickItem*>());
     }
     if(cutLine) {
+        updateBounds();
         QList<QQuickItem*> intersectedEdges;
         int cutLineSize = cutLine->pointCount();
-        for(auto e: m_edges) {
-            for(int i = 0; i < cutLineSize - 1; ++i) {
-                bool intersected = e->intersectWith(cutLine->pointAt(i), cutLine->pointAt(i + 1));
-                if(intersected) {
-                    intersectedEdges.append(e);
-                    break;
+        for(int i = 0; i < cutLineSize - 1; ++i) {
+            QPointF p1 = m_canvas->mapFromItem(this, cutLine->pointAt(i));
+            QPointF p2 = m_canvas->mapFromItem(this, cutLine->pointAt(i + 1));
+            for(QQuickItem *item: m_edgesIndex.query(canvasToWorld(QRectF(p1, p2).normalized()))) {
+                if(intersectedEdges.contains(item)) continue;
+                if(static_cast<Edge*>(item)->intersectWith(p1, p2)) {
+                    intersectedEdges.append(item);
                 }
             }
         }
@@ -494,7 +608,7 @@ void Scene::serialize(QJsonObject &json) const {
     json["resY"] = m_resolution.y();
 }
 
-void Scene::deserialize(const QJsonObject &json) {
+void Scene::deserialize(const QJsonObject &json, const QHash<QUuid, CachedOutput> &outputs) {
     background()->setViewScale(1.0f);
     background()->setViewPan(QVector2D(0, 0));
     if(json.contains("resX") && json.contains("resY")) {
@@ -502,43 +616,495 @@ void Scene::deserialize(const QJsonObject &json) {
         m_preview3d->setTexResolution(m_resolution);
     }
 
+    QJsonArray frames = json["frames"].toArray();
+    QJsonArray nodes = json["nodes"].toArray();
+    QJsonArray edges = json["edges"].toArray();
+    int total = frames.size() + nodes.size() + edges.size();
+    int progress = 0;
+    m_loading = true;
+    suspendEvaluation();
+
     QHash<QUuid, Socket*> socketsHash;
-    if(json.contains("frames") && json["frames"].isArray()) {
-        QJsonArray frames = json["frames"].toArray();
-        for(int i = 0; i < frames.size(); ++i) {
-            QJsonObject framesObject = frames[i].toObject();
-            Frame *frame = new Frame(this);
-            addFrame(frame);
-            frame->deserialize(framesObject, socketsHash);
-        }
-    }
-
-    if(json.contains("nodes") && json["nodes"].isArray()) {
-        QJsonArray nodes = json["nodes"].toArray();
-        for(int i = 0; i < nodes.size(); ++i) {
-            QJsonObject nodesObject = nodes[i].toObject();
-            if(nodesObject.contains("type")) {
-                Node *node = deserializeNode(nodesObject);
-                if(node) {
-                    addNode(node);
-                    node->deserialize(nodesObject, socketsHash);
-                }
+    for(int i = 0; i < frames.size(); ++i) {
+        QJsonObject framesObject = frames[i].toObject();
+        Frame *frame = new Frame(this);
+        addFrame(frame);
+        frame->deserialize(framesObject, socketsHash);
+        reportLoadProgress(++progress, total);
+    }
+
+    for(int i = 0; i < nodes.size(); ++i) {
+        QJsonObject nodesObject = nodes[i].toObject();
+        if(nodesObject.contains("type")) {
+            Node *node = deserializeNode(nodesObject);
+            if(node) {
+                addNode(node);
+                node->deserialize(nodesObject, socketsHash);
             }
         }
+        reportLoadProgress(++progress, total);
     }
 
-    if(json.contains("edges") && json["edges"].isArray()) {
-        QJsonArray edges = json["edges"].toArray();
-        for(int i = 0; i < edges.size(); ++i) {
-            QJsonObject edgesObject = edges[i].toObject();
-            Edge *e = new Edge(this);
-            e->deserialize(edgesObject, socketsHash);
-            if(e->startSocket() && e->endSocket()) m_edges.append(e);
-            else delete e;
+    for(int i = 0; i < edges.size(); ++i) {
+        QJsonObject edgesObject = edges[i].toObject();
+        Edge *e = new Edge(m_canvas);
+        e->deserialize(edgesObject, socketsHash);
+        if(e->startSocket() && e->endSocket()) {
+            m_edges.append(e);
+            edgesChanged();
+            indexItem(e);
+        }
+        else delete e;
+        reportLoadProgress(++progress, total);
+    }
+
+    if(!outputs.isEmpty()) restoreOutputs(outputs);
+    m_loading = false;
+    resumeEvaluation();
+}
+
+void Scene::suspendEvaluation() {
+    m_evaluationSuspended = true;
+}
+
+void Scene::resumeEvaluation() {
+    if(!m_evaluationSuspended) return;
+    QList<Node*> order = evaluationOrder(m_deferredNodes.values());
+    m_deferredNodes.clear();
+    m_evaluationSuspended = false;
+    for(auto node: order) {
+        node->operation();
+    }
+}
+
+bool Scene::evaluationSuspended() const {
+    return m_evaluationSuspended;
+}
+
+bool Scene::loading() const {
+    return m_loading;
+}
+
+void Scene::deferOperation(Node *node) {
+    m_deferredNodes.insert(node);
+}
+
+bool Scene::outputUnchanged(Node *node) {
+    return m_restoredHashes.contains(node) && m_restoredHashes[node] == outputHash(node);
+}
+
+void Scene::outputInvalidated(Node *node) {
+    invalidateOutputHash(node);
+    m_restoredHashes.remove(node);
+    updateAdjacency();
+    for(auto source: m_nodeSources.value(node)) {
+        uploadCachedOutput(source);
+    }
+    for(auto target: m_nodeTargets.value(node)) {
+        if(target->outputRestored() && !outputUnchanged(target)) {
+            m_lazyOutputs.remove(target);
+            target->operation();
         }
     }
 }
 
+void Scene::restoreOutputs(const QHash<QUuid, CachedOutput> &outputs) {
+    updateAdjacency();
+    QSet<Node*> restored;
+    for(auto node: evaluationOrder(m_nodes)) {
+        QUuid id = node->outputId();
+        if(id.isNull() || !outputs.contains(id)) continue;
+        bool sourcesRestored = true;
+        for(auto source: m_nodeSources.value(node)) {
+            if(!restored.contains(source)) sourcesRestored = false;
+        }
+        if(!sourcesRestored) continue;
+        restored.insert(node);
+        m_deferredNodes.remove(node);
+        m_lazyOutputs[node] = outputs[id];
+        m_restoredHashes[node] = outputs[id].hash;
+        node->markOutputRestored();
+    }
+    // outputs feeding a node that is evaluated anyway are needed right away,
+    // the rest are uploaded once their node comes into view
+    for(auto node: restored) {
+        for(auto target: m_nodeTargets.value(node)) {
+            if(!restored.contains(target)) {
+                uploadCachedOutput(node);
+                break;
+            }
+        }
+    }
+}
+
+void Scene::uploadCachedOutput(Node *node) {
+    if(!m_lazyOutputs.contains(node)) return;
+    CachedOutput output = m_lazyOutputs.take(node);
+    QByteArray data = output.bytes();
+    if(data.isEmpty() || !node->restoreOutput(data, output.resolution)) node->operation();
+}
+
+void Scene::applyNodeProperty(Node *node, const char *propName, QVariant value) {
+    // only costly nodes are cached, a cheap source re-renders and the restored nodes below it
+    // skip their own re-render since their hash is unchanged
+    QList<Node*> affected = downstreamNodes(node);
+    suspendEvaluation();
+    node->setPropertyOnPanel(propName, value);
+    QSet<Node*> restored;
+    for(auto n: evaluationOrder(affected)) {
+        QByteArray hash = outputHash(n);
+        CachedTexture *cached = m_outputCache.object(hash);
+        if(!cached || !n->restoreOutput(cached->data, cached->size)) continue;
+        m_restoredHashes[n] = hash;
+        m_lazyOutputs.remove(n);
+        m_deferredNodes.remove(n);
+        restored.insert(n);
+    }
+    resumeEvaluation();
+    if(!m_retainOutputs) return;
+    for(auto n: affected) {
+        if(!restored.contains(n)) m_awaitedOutputs.insert(n);
+    }
+    retainReadyOutputs();
+}
+
+void Scene::retainOutputs(Node *node) {
+    if(!m_retainOutputs) return;
+    for(auto n: downstreamNodes(node)) {
+        m_awaitedOutputs.insert(n);
+    }
+    retainReadyOutputs();
+}
+
+void Scene::restoreCopiedOutputs(const QHash<Node*, CopiedOutput> &copies) {
+    // a copy whose content hash still matches its source starts from the source's output:
+    // a GPU copy of the live texture, else the mapped or cached pixels, shared rather than duplicated
+    for(auto node: copies.keys()) {
+        QByteArray hash = outputHash(node);
+        if(hash.isEmpty()) continue;
+        Node *source = copies[node].source;
+        Scene *sourceScene = source ? sceneOf(source) : nullptr;
+        bool restored = false;
+        if(sourceScene && copies[node].hash == hash && !sourceScene->m_deferredNodes.contains(source) &&
+           sourceScene->outputHash(source) == hash) {
+            if(sourceScene->m_lazyOutputs.contains(source)) {
+                CachedOutput output = sourceScene->m_lazyOutputs[source];
+                QByteArray data = output.bytes();
+                if(sourceScene != this) data.detach();
+                restored = !data.isEmpty() && node->restoreOutput(data, output.resolution);
+            }
+            else {
+                restored = node->copyOutput(source);
+            }
+        }
+        if(!restored) {
+            CachedTexture *cached = m_outputCache.object(hash);
+            if(!cached && sourceScene) cached = sourceScene->m_outputCache.object(hash);
+            restored = cached && node->restoreOutput(cached->data, cached->size);
+        }
+        if(!restored) continue;
+        m_restoredHashes[node] = hash;
+        m_deferredNodes.remove(node);
+    }
+}
+
+void Scene::retainReadyOutputs() {
+    // outputs are read back level by level, a node only once everything it reads from has been,
+    // so the readback trails the re-render cascade instead of catching it halfway;
+    // cheap nodes only report that they have been drawn, their pixels are not kept
+    updateAdjacency();
+    QList<Node*> ready;
+    for(auto node: m_awaitedOutputs) {
+        bool sourcesSettled = true;
+        for(auto source: m_nodeSources.value(node)) {
+            if(m_awaitedOutputs.contains(source) || m_retainingNodes.contains(source)) sourcesSettled = false;
+        }
+        if(sourcesSettled) ready.push_back(node);
+    }
+    for(auto node: ready) {
+        m_awaitedOutputs.remove(node);
+        bool costly = node->costlyOperation();
+        m_retainingNodes[node] = costly ? outputHash(node) : QByteArray();
+        node->captureOutput(costly);
+    }
+}
+
+bool Scene::retainOutputs() const {
+    return m_retainOutputs;
+}
+
+bool Scene::compressOutputs() const {
+    return m_compressOutputs;
+}
+
+void Scene::setCompressOutputs(bool compress) {
+    m_compressOutputs = compress;
+}
+
+void Scene::setRetainOutputs(bool retain) {
+    m_retainOutputs = retain;
+    if(retain) return;
+    m_awaitedOutputs.clear();
+    m_outputCache.clear();
+}
+
+static QByteArray nodeOutputHash(QJsonObject params, const QByteArray &resolution,
+                                 const std::function<QByteArray(const QString&)> &sourceHash) {
+    QJsonArray inputs = params["inputs"].toArray();
+    for(auto input: params["additionals"].toArray()) {
+        inputs.append(input);
+    }
+    params.remove("baseX");
+    params.remove("baseY");
+    params.remove("inputs");
+    params.remove("outputs");
+    params.remove("additionals");
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(sceneFormatVersion));
+    hash.addData(resolution);
+    hash.addData(QJsonDocument(params).toJson(QJsonDocument::Compact));
+    for(auto input: inputs) {
+        hash.addData(sourceHash(input.toObject()["id"].toString()));
+    }
+    return hash.result();
+}
+
+QByteArray Scene::outputHash(Node *node) {
+    // hashes are kept per node until invalidateOutputHash() drops them with everything downstream,
+    // a lookup serializes only the nodes whose hash is missing
+    if(node->outputId().isNull()) return QByteArray();
+    if(m_outputHashes.contains(node)) return m_outputHashes[node];
+    updateAdjacency();
+    QByteArray resolution = QByteArray::number(int(m_resolution.x())) + "x" + QByteArray::number(int(m_resolution.y()));
+    QSet<Node*> visiting;
+    std::function<QByteArray(Node*)> nodeHash = [&](Node *n) {
+        if(m_outputHashes.contains(n) || visiting.contains(n)) return m_outputHashes.value(n);
+        visiting.insert(n);
+        QJsonObject params;
+        n->serialize(params);
+        QByteArray hash = nodeOutputHash(params, resolution, [&](const QString &input) {
+            Node *source = m_inputSources.value(input);
+            return source ? nodeHash(source) : QByteArray("-");
+        });
+        m_outputHashes[n] = hash;
+        return hash;
+    };
+    return nodeHash(node);
+}
+
+void Scene::invalidateOutputHash(Node *node) {
+    // a hash is only cached once all of its sources are, so the walk stops at the first node without one
+    if(!m_outputHashes.remove(node)) return;
+    updateAdjacency();
+    QList<Node*> nodes;
+    nodes.push_back(node);
+    for(int i = 0; i < nodes.count(); ++i) {
+        for(auto target: m_nodeTargets.value(nodes[i])) {
+            if(m_outputHashes.remove(target)) nodes.push_back(target);
+        }
+    }
+}
+
+void Scene::edgesChanged() {
+    m_adjacencyDirty = true;
+}
+
+void Scene::updateAdjacency() {
+    // rebuilt from m_edges only after the graph has changed, lookups in between are hash lookups
+    if(!m_adjacencyDirty) return;
+    m_nodeSources.clear();
+    m_nodeTargets.clear();
+    m_inputSources.clear();
+    for(auto edge: m_edges) {
+        if(!edge->startSocket() || !edge->endSocket()) continue;
+        Node *start = qobject_cast<Node*>(edge->startSocket()->parentItem());
+        Node *end = qobject_cast<Node*>(edge->endSocket()->parentItem());
+        if(!start || !end) continue;
+        m_nodeSources[end].push_back(start);
+        m_nodeTargets[start].push_back(end);
+        m_inputSources[edge->endSocket()->id().toString()] = start;
+    }
+    m_adjacencyDirty = false;
+}
+
+QList<Node*> Scene::downstreamNodes(Node *node) {
+    updateAdjacency();
+    QList<Node*> nodes;
+    QSet<Node*> visited;
+    nodes.push_back(node);
+    visited.insert(node);
+    for(int i = 0; i < nodes.count(); ++i) {
+        for(auto target: m_nodeTargets.value(nodes[i])) {
+            if(visited.contains(target)) continue;
+            visited.insert(target);
+            nodes.push_back(target);
+        }
+    }
+    return nodes;
+}
+
+QHash<QUuid, QByteArray> Scene::outputHashes(const QJsonObject &json) const {
+    QList<QJsonObject> nodes;
+    for(auto node: json["nodes"].toArray()) {
+        nodes.append(node.toObject());
+    }
+    for(auto frame: json["frames"].toArray()) {
+        for(auto node: frame.toObject()["nodes"].toArray()) {
+            nodes.append(node.toObject());
+        }
+    }
+    QHash<QString, QString> edgeSources;
+    for(auto edge: json["edges"].toArray()) {
+        QJsonObject edgeObject = edge.toObject();
+        edgeSources[edgeObject["end"].toString()] = edgeObject["start"].toString();
+    }
+    QHash<QString, int> owners;
+    for(int i = 0; i < nodes.count(); ++i) {
+        for(auto output: nodes[i]["outputs"].toArray()) {
+            owners[output.toObject()["id"].toString()] = i;
+        }
+    }
+    QByteArray resolution = QByteArray::number(json["resX"].toInt()) + "x" + QByteArray::number(json["resY"].toInt());
+    QVector<QByteArray> hashes(nodes.count());
+    QVector<bool> visiting(nodes.count(), false);
+    std::function<QByteArray(int)> nodeHash = [&](int idx) {
+        if(!hashes[idx].isEmpty() || visiting[idx]) return hashes[idx];
+        visiting[idx] = true;
+        hashes[idx] = nodeOutputHash(nodes[idx], resolution, [&](const QString &input) {
+            QString source = edgeSources.value(input);
+            return owners.contains(source) ? nodeHash(owners[source]) : QByteArray("-");
+        });
+        return hashes[idx];
+    };
+    QHash<QUuid, QByteArray> result;
+    for(int i = 0; i < nodes.count(); ++i) {
+        QJsonArray outputs = nodes[i]["outputs"].toArray();
+        if(outputs.size() != 1) continue;
+        result[QUuid(outputs[0].toObject()["id"].toString())] = nodeHash(i);
+    }
+    return result;
+}
+
+QList<Node*> Scene::evaluationOrder(QList<Node*> nodes) {
+    updateAdjacency();
+    QHash<Node*, int> inDegree;
+    for(auto node: m_nodes) {
+        inDegree[node] = m_nodeSources.value(node).count();
+    }
+    QList<Node*> sorted;
+    for(auto node: m_nodes) {
+        if(inDegree[node] == 0) sorted.push_back(node);
+    }
+    for(int i = 0; i < sorted.count(); ++i) {
+        for(auto next: m_nodeTargets.value(sorted[i])) {
+            if(--inDegree[next] == 0) sorted.push_back(next);
+        }
+    }
+    QSet<Node*> requested;
+    for(auto node: nodes) {
+        requested.insert(node);
+    }
+    QList<Node*> order;
+    for(auto node: sorted) {
+        if(requested.remove(node)) order.push_back(node);
+    }
+    for(auto node: requested) {
+        order.push_back(node);
+    }
+    return order;
+}
+
+void Scene::reportLoadProgress(int value, int total) {
+    // the event loop runs here so the tab can repaint, edits and closing wait for loading() to clear
+    emit loadProgress(value, total);
+    if(value % loadProgressStep == 0 || value == total) {
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+}
+
+void Scene::updatePolish() {
+    updateBounds();
+    QRectF view = m_canvas->mapRectFromItem(this, boundingRect());
+    view.adjust(-viewportMargin, -viewportMargin, viewportMargin, viewportMargin);
+    detailLevel level = m_background->viewScale() < placeholderScale ? PLACEHOLDER : FULL_DETAIL;
+    QSet<Node*> detailed;
+    for(QQuickItem *item: m_nodesIndex.query(canvasToWorld(view))) {
+        Node *node = static_cast<Node*>(item);
+        node->setDetail(level);
+        uploadCachedOutput(node);
+        detailed.insert(node);
+    }
+    for(Node *node: m_detailedNodes) {
+        if(!detailed.contains(node)) node->setDetail(CULLED);
+    }
+    m_detailedNodes = detailed;
+}
+
+void Scene::itemBoundsChanged() {
+    m_dirtyBounds.insert(qobject_cast<QQuickItem*>(sender()));
+    polish();
+}
+
+void Scene::updateCanvasPan(QVector2D pan) {
+    m_canvas->setPosition(QPointF(-pan.x(), -pan.y()));
+    polish();
+}
+
+void Scene::indexItem(QQuickItem *item) {
+    if(qobject_cast<Edge*>(item)) {
+        Edge *edge = qobject_cast<Edge*>(item);
+        connect(edge, &Edge::startPositionChanged, this, &Scene::itemBoundsChanged);
+        connect(edge, &Edge::endPositionChanged, this, &Scene::itemBoundsChanged);
+        m_edgesIndex.insert(edge, worldBounds(edge));
+        return;
+    }
+    connect(item, &QQuickItem::xChanged, this, &Scene::itemBoundsChanged);
+    connect(item, &QQuickItem::yChanged, this, &Scene::itemBoundsChanged);
+    connect(item, &QQuickItem::widthChanged, this, &Scene::itemBoundsChanged);
+    connect(item, &QQuickItem::heightChanged, this, &Scene::itemBoundsChanged);
+    if(qobject_cast<Node*>(item)) m_nodesIndex.insert(item, worldBounds(item));
+    else if(qobject_cast<Frame*>(item)) m_framesIndex.insert(item, worldBounds(item));
+}
+
+void Scene::unindexItem(QQuickItem *item) {
+    if(qobject_cast<Edge*>(item)) {
+        Edge *edge = qobject_cast<Edge*>(item);
+        disconnect(edge, &Edge::startPositionChanged, this, &Scene::itemBoundsChanged);
+        disconnect(edge, &Edge::endPositionChanged, this, &Scene::itemBoundsChanged);
+    }
+    else {
+        disconnect(item, &QQuickItem::xChanged, this, &Scene::itemBoundsChanged);
+        disconnect(item, &QQuickItem::yChanged, this, &Scene::itemBoundsChanged);
+        disconnect(item, &QQuickItem::widthChanged, this, &Scene::itemBoundsChanged);
+        disconnect(item, &QQuickItem::heightChanged, this, &Scene::itemBoundsChanged);
+    }
+    m_nodesIndex.remove(item);
+    m_framesIndex.remove(item);
+    m_edgesIndex.remove(item);
+    m_dirtyBounds.remove(item);
+}
+
+void Scene::updateBounds() {
+    for(QQuickItem *item: m_dirtyBounds) {
+        if(m_nodesIndex.contains(item)) m_nodesIndex.insert(item, worldBounds(item));
+        else if(m_framesIndex.contains(item)) m_framesIndex.insert(item, worldBounds(item));
+        else if(m_edgesIndex.contains(item)) m_edgesIndex.insert(item, worldBounds(item));
+    }
+    m_dirtyBounds.clear();
+}
+
+QRectF Scene::worldBounds(QQuickItem *item) {
+    if(qobject_cast<Edge*>(item)) {
+        return canvasToWorld(qobject_cast<Edge*>(item)->curveBounds());
+    }
+    return canvasToWorld(QRectF(item->x(), item->y(), item->width(), item->height()));
+}
+
+QRectF Scene::canvasToWorld(QRectF rect) {
+    float scale = m_background->viewScale();
+    return QRectF(rect.x()/scale, rect.y()/scale, rect.width()/scale, rect.height()/scale);
+}
+
 Node *Scene::deserializeNode(const QJsonObject &json) {
     int nodeType = json["type"].toInt();
     Node *node = nullptr;
@@ -609,6 +1175,9 @@ Node *Scene::deserializeNode(const QJsonObject &json) {
     case 22:
         node = new ThresholdNode(this, m_resolution);
         break;
+    case 23:
+        node = new HeightNode(this, m_resolution);
+        break;
     default:
         std::cout << "nonexistent type" << std::endl;
     }
@@ -634,11 +1203,13 @@ bool Scene::saveScene(QString fileName) {
     if(fileName.isEmpty()) {
         name = QFileDialog::getSaveFileName(nullptr,
                 tr("Save Node Scene"), "",
-                tr("Node Scene (*.sne);"));
+                tr("Node Scene (*.sne);;Node Scene with Outputs (*.snb)"));
     }
+    if(name.endsWith(".snb")) return saveBinaryScene(name);
     QFile saveFile(name);
     if(!saveFile.open(QIODevice::WriteOnly)) {
         qWarning("Couldn`t open save file.");
+        saveFinished(name, false);
         return false;
     }
     QJsonObject sceneObject;
@@ -648,6 +1219,146 @@ bool Scene::saveScene(QString fileName) {
     m_fileName = name;
     m_modified = false;
     fileNameUpdate(m_fileName, false);
+    saveFinished(name, true);
+    return true;
+}
+
+bool Scene::saveBinaryScene(QString fileName) {
+    // outputs are read back from the renderers, so the file is written once they have all arrived
+    // or the timeout gives up on the rest; saveFinished() reports the result either way
+    if(!m_savingNodes.isEmpty()) {
+        m_savingNodes.clear();
+        writeBinaryScene();
+    }
+    m_saveName = fileName;
+    m_saveObject = QJsonObject();
+    serialize(m_saveObject);
+    // edits made while the outputs are captured set it again, so they aren't reported as saved
+    m_modified = false;
+    m_capturedOutputs.clear();
+    m_mappedOutputs.clear();
+    QList<Node*> nodes;
+    for(auto node: m_nodes) {
+        if(m_lazyOutputs.contains(node)) {
+            // written straight from the mapping, the file stays mapped until the save is written
+            m_mappedOutputs[node->outputId()] = m_lazyOutputs[node];
+        }
+        else {
+            nodes.push_back(node);
+        }
+    }
+    m_savingNodes.clear();
+    for(auto node: nodes) {
+        m_savingNodes.insert(node);
+    }
+    if(m_savingNodes.isEmpty()) return writeBinaryScene();
+    m_saveTimer.start();
+    for(auto node: nodes) {
+        node->captureOutput();
+    }
+    return true;
+}
+
+void Scene::saveTimedOut() {
+    if(m_savingNodes.isEmpty()) return;
+    qWarning("Not all outputs were captured, saving without them.");
+    m_savingNodes.clear();
+    writeBinaryScene();
+}
+
+void Scene::nodeOutputCaptured(QByteArray data, QSize size) {
+    Node *node = qobject_cast<Node*>(sender());
+    if(!node) return;
+    if(m_retainingNodes.contains(node)) {
+        QByteArray hash = m_retainingNodes.take(node);
+        if(!data.isEmpty() && !hash.isEmpty() && hash == outputHash(node)) {
+            m_outputCache.insert(hash, new CachedTexture{data, size}, data.size());
+        }
+        retainReadyOutputs();
+        // a capture without pixels can't be the one a save is waiting for
+        if(hash.isEmpty() && data.isEmpty()) return;
+    }
+    if(m_savingNodes.remove(node)) {
+        if(!data.isEmpty()) m_capturedOutputs[node->outputId()] = qMakePair(size, data);
+        if(m_savingNodes.isEmpty()) writeBinaryScene();
+    }
+}
+
+bool Scene::writeBinaryScene() {
+    m_saveTimer.stop();
+    QHash<QUuid, QByteArray> hashes = outputHashes(m_saveObject);
+    QCborArray outputs;
+    QList<QByteArray> blobs;
+    QList<CachedOutput> mappedBlobs;
+    QHash<QUuid, qint64> offsets;
+    qint64 offset = 0;
+    auto addOutput = [&](const QUuid &id, QSize resolution, qint64 size, bool compressed) {
+        QCborMap output;
+        output[QStringLiteral("id")] = id.toString();
+        output[QStringLiteral("hash")] = hashes[id];
+        output[QStringLiteral("width")] = resolution.width();
+        output[QStringLiteral("height")] = resolution.height();
+        output[QStringLiteral("offset")] = offset;
+        output[QStringLiteral("size")] = size;
+        if(compressed) output[QStringLiteral("compressed")] = true;
+        outputs.append(output);
+        offsets[id] = offset;
+        offset += size;
+    };
+    for(auto it = m_capturedOutputs.begin(); it != m_capturedOutputs.end(); ++it) {
+        if(!hashes.contains(it.key())) continue;
+        QByteArray blob = m_compressOutputs ? qCompress(it.value().second) : it.value().second;
+        addOutput(it.key(), it.value().first, blob.size(), m_compressOutputs);
+        blobs.append(blob);
+    }
+    // outputs still mapped from a loaded file keep the form they were stored in
+    for(auto it = m_mappedOutputs.begin(); it != m_mappedOutputs.end(); ++it) {
+        if(!hashes.contains(it.key()) || m_capturedOutputs.contains(it.key())) continue;
+        addOutput(it.key(), it.value().resolution, it.value().size, it.value().compressed);
+        mappedBlobs.append(it.value());
+    }
+    QCborMap root;
+    root[QStringLiteral("version")] = sceneFormatVersion;
+    root[QStringLiteral("scene")] = QCborMap::fromJsonObject(m_saveObject);
+    root[QStringLiteral("outputs")] = outputs;
+    m_capturedOutputs.clear();
+    m_saveObject = QJsonObject();
+
+    QSaveFile saveFile(m_saveName);
+    if(!saveFile.open(QIODevice::WriteOnly)) {
+        qWarning("Couldn`t open save file.");
+        m_mappedOutputs.clear();
+        m_modified = true;
+        fileNameUpdate(m_fileName, m_modified);
+        saveFinished(m_saveName, false);
+        return false;
+    }
+    // the index comes first, the outputs follow it so uncompressed ones can be mapped and uploaded in place
+    QByteArray index = QCborValue(QCborKnownTags::Signature, root).toCbor();
+    saveFile.write(index);
+    for(auto &blob: blobs) {
+        saveFile.write(blob);
+    }
+    for(auto &output: mappedBlobs) {
+        saveFile.write(reinterpret_cast<const char*>(output.data), output.size);
+    }
+    m_mappedOutputs.clear();
+    for(auto &fileOffset: offsets) {
+        fileOffset += index.size();
+    }
+    QFile *released = releaseSceneFile(m_saveName);
+    bool committed = saveFile.commit();
+    if(released) remapSceneFile(released, committed, offsets);
+    if(!committed) {
+        qWarning("Couldn`t write save file.");
+        m_modified = true;
+        fileNameUpdate(m_fileName, m_modified);
+        saveFinished(m_saveName, false);
+        return false;
+    }
+    m_fileName = m_saveName;
+    fileNameUpdate(m_fileName, m_modified);
+    saveFinished(m_saveName, true);
     return true;
 }
 
@@ -657,15 +1368,116 @@ bool Scene::loadScene(QString fileName) {
         qWarning("Couldn`t open save file.");
         return false;
     }
-    QByteArray saveData = loadFile.readAll();
-    QJsonDocument loadDoc(QJsonDocument::fromJson(saveData));
-    deserialize(loadDoc.object());
+    if(loadFile.peek(cborSignature.size()) == cborSignature) {
+        loadFile.close();
+        if(!loadBinaryScene(fileName)) {
+            qWarning("Couldn`t read save file.");
+            return false;
+        }
+    }
+    else {
+        QByteArray saveData = loadFile.readAll();
+        QJsonDocument loadDoc(QJsonDocument::fromJson(saveData));
+        deserialize(loadDoc.object());
+    }
     m_modified = false;
     m_fileName = fileName;
     fileNameUpdate(m_fileName, false);
     return true;
 }
 
+bool Scene::loadBinaryScene(QString fileName) {
+    QFile *file = new QFile(fileName);
+    uchar *data = file->open(QIODevice::ReadOnly) ? file->map(0, file->size()) : nullptr;
+    if(!data) {
+        delete file;
+        return false;
+    }
+    QByteArray mapped = QByteArray::fromRawData(reinterpret_cast<const char*>(data), file->size());
+    QCborStreamReader reader(mapped);
+    QCborValue root = QCborValue::fromCbor(reader);
+    qint64 dataOffset = reader.currentOffset();
+    if(root.isTag()) root = root.taggedValue();
+    QCborMap rootMap = root.toMap();
+    qint64 version = rootMap.value(QStringLiteral("version")).toInteger();
+    if(version != sceneFormatVersion) {
+        delete file;
+        return false;
+    }
+    QJsonObject sceneObject = rootMap.value(QStringLiteral("scene")).toMap().toJsonObject();
+    QHash<QUuid, QByteArray> hashes = outputHashes(sceneObject);
+    QHash<QUuid, CachedOutput> outputs;
+    for(auto entry: rootMap.value(QStringLiteral("outputs")).toArray()) {
+        QCborMap outputMap = entry.toMap();
+        QUuid id(outputMap.value(QStringLiteral("id")).toString());
+        if(!hashes.contains(id) || hashes[id] != outputMap.value(QStringLiteral("hash")).toByteArray()) continue;
+        qint64 width = outputMap.value(QStringLiteral("width")).toInteger();
+        qint64 height = outputMap.value(QStringLiteral("height")).toInteger();
+        qint64 offset = outputMap.value(QStringLiteral("offset")).toInteger();
+        qint64 size = outputMap.value(QStringLiteral("size")).toInteger();
+        bool compressed = outputMap.value(QStringLiteral("compressed")).toBool();
+        if(width <= 0 || height <= 0 || width > maxOutputSide || height > maxOutputSide) continue;
+        if(compressed ? size <= 0 : size != 4*width*height) continue;
+        if(offset < 0 || offset > file->size() - dataOffset || size > file->size() - dataOffset - offset) continue;
+        CachedOutput output;
+        output.size = size;
+        output.offset = dataOffset + offset;
+        output.compressed = compressed;
+        output.resolution = QSize(static_cast<int>(width), static_cast<int>(height));
+        output.data = data + output.offset;
+        output.hash = hashes[id];
+        output.file = file;
+        outputs[id] = output;
+    }
+    // stays mapped while any output may still be uploaded from it
+    m_sceneFiles.append(file);
+    deserialize(sceneObject, outputs);
+    return true;
+}
+
+QFile *Scene::releaseSceneFile(const QString &fileName) {
+    // a mapped file can't be replaced on every platform, so its mapping is closed before the save
+    // is renamed over it; remapSceneFile() points the outputs still read from it at the file on disk
+    QFileInfo target(fileName);
+    for(auto file: m_sceneFiles) {
+        if(QFileInfo(file->fileName()) != target) continue;
+        for(auto node: m_nodes) {
+            node->detachRestoreData();
+        }
+        file->close();
+        return file;
+    }
+    return nullptr;
+}
+
+void Scene::remapSceneFile(QFile *file, bool replaced, const QHash<QUuid, qint64> &offsets) {
+    // offsets are those of the file just written, they only apply once it has replaced the old one
+    uchar *data = file->open(QIODevice::ReadOnly) ? file->map(0, file->size()) : nullptr;
+    QList<Node*> lost;
+    for(auto it = m_lazyOutputs.begin(); it != m_lazyOutputs.end();) {
+        if(it->file != file) {
+            ++it;
+            continue;
+        }
+        QUuid id = it.key()->outputId();
+        if(replaced) it->offset = offsets.value(id, -1);
+        if(!data || it->offset < 0 || it->offset + it->size > file->size()) {
+            lost.push_back(it.key());
+            it = m_lazyOutputs.erase(it);
+            continue;
+        }
+        it->data = data + it->offset;
+        ++it;
+    }
+    if(!data) {
+        m_sceneFiles.removeOne(file);
+        delete file;
+    }
+    for(auto node: lost) {
+        node->operation();
+    }
+}
+
 QString Scene::fileName() {
     return m_fileName;
 }
@@ -703,8 +1515,45 @@ void Scene::removeFromFrame() {
     detachedFromFrame(data);
 }
 
+void Scene::moveItems(QList<QQuickItem *> items, QVector2D offset) {
+    QList<QVector2D> positions;
+    for(auto item: items) {
+        if(qobject_cast<Node*>(item)) {
+            Node *n = qobject_cast<Node*>(item);
+            positions.push_back(QVector2D(n->baseX(), n->baseY()) + offset);
+        }
+        else if(qobject_cast<Frame*>(item)) {
+            Frame *f = qobject_cast<Frame*>(item);
+            positions.push_back(QVector2D(f->baseX(), f->baseY()) + offset);
+        }
+        else {
+            positions.push_back(QVector2D());
+        }
+    }
+    moveItems(items, positions);
+}
+
+void Scene::moveItems(QList<QQuickItem *> items, QList<QVector2D> positions) {
+    QSet<Frame*> resizedFrames;
+    for(int i = 0; i < items.count(); ++i) {
+        QQuickItem *item = items[i];
+        if(qobject_cast<Node*>(item)) {
+            Node *n = qobject_cast<Node*>(item);
+            n->setBasePosition(positions[i]);
+            if(n->attachedFrame() && !n->attachedFrame()->selected()) resizedFrames.insert(n->attachedFrame());
+        }
+        else if(qobject_cast<Frame*>(item)) {
+            Frame *f = qobject_cast<Frame*>(item);
+            f->setBasePosition(positions[i]);
+        }
+    }
+    for(auto frame: resizedFrames) {
+        frame->resizeByContent();
+    }
+}
+
 void Scene::movedNodes(QList<QQuickItem *> nodes, QVector2D vec, Frame *frame) {
-    m_undoStack->push(new MoveCommand(nodes, vec, frame));
+    m_undoStack->push(new MoveCommand(nodes, vec, this, frame));
     if(!m_modified) {
         m_modified = true;
         fileNameUpdate(m_fileName, m_modified);
@@ -740,7 +1589,7 @@ void Scene::movedEdge(Edge *edge, Socket *oldEndSocket, Socket *newEndSocket) {
 }
 
 void Scene::nodePropertyChanged(Node *node, const char *propName, QVariant newValue, QVariant oldValue) {
-    m_undoStack->push(new PropertyChangeCommand(node, propName, newValue, oldValue));
+    m_undoStack->push(new PropertyChangeCommand(node, propName, newValue, oldValue, this));
 }
 
 void Scene::detachedFromFrame(QList<QPair<QQuickItem *, Frame *> > data) {
@@ -771,11 +1620,16 @@ bool Scene::normalConnected() {
     return m_normalConnected;
 }
 
+bool Scene::heightConnected() {
+    return m_heightConnected;
+}
+
 QVector2D Scene::resolution() {
     return m_resolution;
 }
 
 void Scene::setResolution(QVector2D res) {
     m_resolution = res;
+    m_outputHashes.clear();
     emit resolutionUpdate(res);
 }
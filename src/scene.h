@@ -23,9 +23,13 @@
 #define SCENE_H
 #include <QQuickItem>
 #include <QVector>
+#include <QSet>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QFile>
+#include <QCache>
+#include <QTimer>
 #include <QtWidgets/QUndoStack>
 #include <QtWidgets/QMenu>
 #include "node.h"
@@ -36,6 +40,28 @@
 #include "clipboard.h"
 #include "preview3d.h"
 #include "cutline.h"
+#include "spatialindex.h"
+
+struct CachedOutput {
+    const uchar *data = nullptr;
+    qint64 size = 0;
+    qint64 offset = 0;
+    bool compressed = false;
+    QSize resolution;
+    QByteArray hash;
+    QFile *file = nullptr;
+    QByteArray bytes() const {
+        QByteArray stored = QByteArray::fromRawData(reinterpret_cast<const char*>(data), size);
+        if(!compressed) return stored;
+        QByteArray pixels = qUncompress(stored);
+        return pixels.size() == 4*resolution.width()*resolution.height() ? pixels : QByteArray();
+    }
+};
+
+struct CachedTexture {
+    QByteArray data;
+    QSize size;
+};
 
 class Scene: public QQuickItem
 {
@@ -55,6 +81,9 @@ public:
     void setEdges(const QList<Edge*> &edges);
     BackgroundObject *background() const;
     Preview3DObject *preview3d() const;
+    EdgeBatch *edgeBatch() const;
+    QQuickItem *canvas() const;
+    static Scene *sceneOf(QQuickItem *item);
     void deleteNode(Node* node);
     void addNode(Node *node);
     Node *nodeAt(float x, float y);
@@ -74,16 +103,35 @@ public:
     void mouseMoveEvent(QMouseEvent *event);
     void mouseReleaseEvent(QMouseEvent *event);
     void serialize(QJsonObject &json) const;
-    void deserialize(const QJsonObject &json);
+    void deserialize(const QJsonObject &json, const QHash<QUuid, CachedOutput> &outputs = QHash<QUuid, CachedOutput>());
     Node *deserializeNode(const QJsonObject &json);
     void deleteItems();
     bool saveScene(QString fileName);
     bool loadScene(QString fileName);
     QString fileName();
+    void suspendEvaluation();
+    void resumeEvaluation();
+    bool evaluationSuspended() const;
+    bool loading() const;
+    void deferOperation(Node *node);
+    bool outputUnchanged(Node *node);
+    void outputInvalidated(Node *node);
+    void applyNodeProperty(Node *node, const char *propName, QVariant value);
+    void retainOutputs(Node *node);
+    bool retainOutputs() const;
+    void setRetainOutputs(bool retain);
+    bool compressOutputs() const;
+    void setCompressOutputs(bool compress);
+    void restoreCopiedOutputs(const QHash<Node*, CopiedOutput> &copies);
+    QByteArray outputHash(Node *node);
+    void invalidateOutputHash(Node *node);
+    void edgesChanged();
     void undo();
     void redo();
     void cut();
     void removeFromFrame();
+    void moveItems(QList<QQuickItem*> items, QVector2D offset);
+    void moveItems(QList<QQuickItem*> items, QList<QVector2D> positions);
     void movedNodes(QList<QQuickItem *> nodes, QVector2D vec, Frame *frame = nullptr);
     void addedEdge(Edge *edge);
     void addedNode(Node *node);
@@ -100,6 +148,7 @@ public:
     bool metalConnected();
     bool roughConnected();
     bool normalConnected();
+    bool heightConnected();
     QVector2D resolution();
     void setResolution(QVector2D res);
 
@@ -109,22 +158,77 @@ public:
     Edge* dragEdge = nullptr;
     Frame* dropFrame = nullptr;
     QQuickItem* rectSelect = nullptr;
-    QQuickView* rectView = nullptr;
     CutLine* cutLine = nullptr;
 signals:
     void activeNodeChanged();
     void fileNameUpdate(QString fileName, bool modified);
     void outputsSave(QString dir);
     void resolutionUpdate(QVector2D res);
+    void loadProgress(int value, int total);
+    void saveFinished(QString fileName, bool saved);
+protected:
+    void updatePolish();
+private slots:
+    void itemBoundsChanged();
+    void updateCanvasPan(QVector2D pan);
+    void nodeOutputCaptured(QByteArray data, QSize size);
+    void saveTimedOut();
 private:
+    void indexItem(QQuickItem *item);
+    void unindexItem(QQuickItem *item);
+    void updateBounds();
+    QRectF worldBounds(QQuickItem *item);
+    QRectF canvasToWorld(QRectF rect);
+    QList<Node*> evaluationOrder(QList<Node*> nodes);
+    void reportLoadProgress(int value, int total);
+    bool saveBinaryScene(QString fileName);
+    bool writeBinaryScene();
+    bool loadBinaryScene(QString fileName);
+    QHash<QUuid, QByteArray> outputHashes(const QJsonObject &json) const;
+    void restoreOutputs(const QHash<QUuid, CachedOutput> &outputs);
+    void uploadCachedOutput(Node *node);
+    QFile *releaseSceneFile(const QString &fileName);
+    void remapSceneFile(QFile *file, bool replaced, const QHash<QUuid, qint64> &offsets);
+    QList<Node*> downstreamNodes(Node *node);
+    void updateAdjacency();
+    void retainReadyOutputs();
     static int nodesCount(QQmlListProperty<Node>* nodes);
     static Node* node(QQmlListProperty<Node>* nodes, int idx);
     BackgroundObject *m_background = nullptr;
     Preview3DObject *m_preview3d = nullptr;
+    QQuickItem *m_canvas = nullptr;
+    EdgeBatch *m_edgeBatch = nullptr;
     QList<Node*> m_nodes;
     QList<Edge*> m_edges;
     QList<Frame*> m_frames;
     QList<QQuickItem*> m_selectedItem;
+    SpatialIndex m_nodesIndex;
+    SpatialIndex m_framesIndex;
+    SpatialIndex m_edgesIndex;
+    QSet<QQuickItem*> m_dirtyBounds;
+    QSet<Node*> m_detailedNodes;
+    QSet<Node*> m_deferredNodes;
+    bool m_evaluationSuspended = false;
+    bool m_loading = false;
+    QSet<Node*> m_savingNodes;
+    QTimer m_saveTimer;
+    bool m_retainOutputs = true;
+    QSet<Node*> m_awaitedOutputs;
+    QHash<Node*, QByteArray> m_retainingNodes;
+    QHash<Node*, QByteArray> m_restoredHashes;
+    QHash<Node*, QByteArray> m_outputHashes;
+    QHash<Node*, QList<Node*>> m_nodeSources;
+    QHash<Node*, QList<Node*>> m_nodeTargets;
+    QHash<QString, Node*> m_inputSources;
+    bool m_adjacencyDirty = true;
+    QCache<QByteArray, CachedTexture> m_outputCache;
+    QString m_saveName;
+    QJsonObject m_saveObject;
+    QHash<QUuid, QPair<QSize, QByteArray>> m_capturedOutputs;
+    QHash<QUuid, CachedOutput> m_mappedOutputs;
+    bool m_compressOutputs = false;
+    QHash<Node*, CachedOutput> m_lazyOutputs;
+    QList<QFile*> m_sceneFiles;
     Node *m_activeNode = nullptr;
     QString m_fileName = "";
     bool m_modified = false;
@@ -133,6 +237,7 @@ private:
     bool m_metalConnected = false;
     bool m_roughConnected = false;
     bool m_normalConnected = false;
+    bool m_heightConnected = false;
     QVector2D m_resolution;
 };
 
@@ -0,0 +1,173 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "shaderwarmup.h"
+#include "hash.h"
+#include <QThread>
+#include <QOpenGLContext>
+#include <QOpenGLShaderProgram>
+#include <QOffscreenSurface>
+
+struct ShaderProgramSource {
+    QOpenGLShader::ShaderType type;
+    const char *fileName;
+};
+
+// indexed by shaderProgram, the renderers and the warm-up link from the same table,
+// so each renderer finds its program in Qt's program binary cache instead of compiling it
+static const QList<ShaderProgramSource> programs[PROGRAM_COUNT] = {
+    {{QOpenGLShader::Vertex, ":/shaders/checker.vert"}, {QOpenGLShader::Fragment, ":/shaders/checker.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/texture.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/noise.vert"}, {QOpenGLShader::Fragment, ":/shaders/noise.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/noise.vert"}, {QOpenGLShader::Fragment, ":/shaders/noiselayers.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/noise.vert"}, {QOpenGLShader::Fragment, ":/shaders/voronoi.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/tile.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/tilescatter.vert"}, {QOpenGLShader::Fragment, ":/shaders/tilescatter.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/tilemask.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/noise.vert"}, {QOpenGLShader::Fragment, ":/shaders/polygon.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/noise.vert"}, {QOpenGLShader::Fragment, ":/shaders/circle.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/noise.vert"}, {QOpenGLShader::Fragment, ":/shaders/color.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/noise.vert"}, {QOpenGLShader::Fragment, ":/shaders/normalmap.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/mix.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/blur.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/warp.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/transform.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/inverse.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/colorramp.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/coloring.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/mapping.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/mirror.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/brightnesscontrast.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/threshold.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/albedo.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texture.vert"}, {QOpenGLShader::Fragment, ":/shaders/onechanel.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/texmatrix.vert"}, {QOpenGLShader::Fragment, ":/shaders/texture.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/grid.vert"}, {QOpenGLShader::Fragment, ":/shaders/grid.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/pbr.vert"}, {QOpenGLShader::Fragment, ":/shaders/pbr.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/pbrdisplace.vert"}, {QOpenGLShader::Fragment, ":/shaders/pbr.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/pbrtess.vert"}, {QOpenGLShader::TessellationControl, ":/shaders/pbr.tesc"},
+     {QOpenGLShader::TessellationEvaluation, ":/shaders/pbr.tese"}, {QOpenGLShader::Fragment, ":/shaders/pbr.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/cubemap.vert"}, {QOpenGLShader::Fragment, ":/shaders/equirectangular.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/cubemap.vert"}, {QOpenGLShader::Fragment, ":/shaders/irradiance.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/cubemap.vert"}, {QOpenGLShader::Fragment, ":/shaders/prefiltered.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/brdf.vert"}, {QOpenGLShader::Fragment, ":/shaders/brdf.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/background.vert"}, {QOpenGLShader::Fragment, ":/shaders/background.frag"}},
+    {{QOpenGLShader::Vertex, ":/shaders/brdf.vert"}, {QOpenGLShader::Fragment, ":/shaders/texture.frag"}}
+};
+
+class ShaderWarmupThread: public QThread
+{
+public:
+    ShaderWarmupThread(ShaderWarmup *warmup, QOffscreenSurface *surface): m_warmup(warmup), m_surface(surface) {}
+protected:
+    void run() {
+        QOpenGLContext *context = new QOpenGLContext();
+        context->setFormat(m_surface->format());
+        context->setShareContext(QOpenGLContext::globalShareContext());
+        if(context->create() && context->makeCurrent(m_surface)) {
+            int index;
+            while(m_warmup->takeProgram(index)) {
+                compileProgram(index);
+            }
+            context->doneCurrent();
+        }
+        delete context;
+        m_warmup->threadFinished();
+    }
+private:
+    void compileProgram(int index) {
+        QElapsedTimer timer;
+        timer.start();
+        QOpenGLShaderProgram *program = createShaderProgram(shaderProgram(index));
+        bool linked = program->isLinked();
+        delete program;
+        QStringList fileNames;
+        for(auto stage: programs[index]) {
+            fileNames.append(QString(stage.fileName).section('/', -1));
+        }
+        qDebug("shader warm-up: %s %s in %lld ms", qPrintable(fileNames.join(" + ")), linked ? "linked" : "failed",
+               timer.elapsed());
+    }
+    ShaderWarmup *m_warmup;
+    QOffscreenSurface *m_surface;
+};
+
+QOpenGLShaderProgram *createShaderProgram(shaderProgram program) {
+    QOpenGLShaderProgram *shader = new QOpenGLShaderProgram();
+    for(auto stage: programs[program]) {
+        shader->addCacheableShaderFromSourceCode(stage.type, shaderWithIncludes(stage.fileName));
+    }
+    shader->link();
+    return shader;
+}
+
+ShaderWarmup *ShaderWarmup::instance() {
+    static ShaderWarmup *warmup = new ShaderWarmup();
+    return warmup;
+}
+
+ShaderWarmup::ShaderWarmup() {
+}
+
+void ShaderWarmup::start() {
+    // surfaces have to be created on the gui thread, the contexts are made on the workers
+    QMutexLocker locker(&m_mutex);
+    if(m_runningThreads > 0 || isReady()) return;
+    m_timer.start();
+    int threadsCount = qBound(1, QThread::idealThreadCount() - 1, 4);
+    for(int i = 0; i < threadsCount; ++i) {
+        QSurfaceFormat format = QSurfaceFormat::defaultFormat();
+        format.setSamples(-1);
+        QOffscreenSurface *surface = new QOffscreenSurface();
+        surface->setFormat(format);
+        surface->create();
+        m_surfaces.append(surface);
+        ShaderWarmupThread *thread = new ShaderWarmupThread(this, surface);
+        connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+        ++m_runningThreads;
+        thread->start(QThread::LowPriority);
+    }
+}
+
+bool ShaderWarmup::isReady() const {
+    return m_ready.load();
+}
+
+bool ShaderWarmup::takeProgram(int &index) {
+    QMutexLocker locker(&m_mutex);
+    if(m_nextProgram >= PROGRAM_COUNT) return false;
+    index = m_nextProgram++;
+    return true;
+}
+
+void ShaderWarmup::threadFinished() {
+    QMutexLocker locker(&m_mutex);
+    if(--m_runningThreads > 0) return;
+    qDebug("shader warm-up: %d programs in %lld ms", PROGRAM_COUNT, m_timer.elapsed());
+    m_ready.store(1);
+    QMetaObject::invokeMethod(this, "finish", Qt::QueuedConnection);
+}
+
+void ShaderWarmup::finish() {
+    qDeleteAll(m_surfaces);
+    m_surfaces.clear();
+    emit ready();
+}
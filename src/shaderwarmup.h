@@ -0,0 +1,68 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHADERWARMUP_H
+#define SHADERWARMUP_H
+#include <QObject>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QStringList>
+
+class QOffscreenSurface;
+class QOpenGLShaderProgram;
+
+enum shaderProgram {PROGRAM_CHECKER, PROGRAM_TEXTURE, PROGRAM_NOISE, PROGRAM_NOISE_LAYERS, PROGRAM_VORONOI,
+                    PROGRAM_TILE, PROGRAM_TILE_SCATTER, PROGRAM_TILE_MASK, PROGRAM_POLYGON, PROGRAM_CIRCLE,
+                    PROGRAM_COLOR, PROGRAM_NORMAL_MAP, PROGRAM_MIX, PROGRAM_BLUR, PROGRAM_WARP, PROGRAM_TRANSFORM,
+                    PROGRAM_INVERSE, PROGRAM_COLOR_RAMP, PROGRAM_COLORING, PROGRAM_MAPPING, PROGRAM_MIRROR,
+                    PROGRAM_BRIGHTNESS_CONTRAST, PROGRAM_THRESHOLD, PROGRAM_ALBEDO, PROGRAM_ONE_CHANNEL,
+                    PROGRAM_PREVIEW_TEXTURE, PROGRAM_GRID, PROGRAM_PBR, PROGRAM_PBR_DISPLACE, PROGRAM_PBR_TESSELLATION,
+                    PROGRAM_EQUIRECTANGULAR, PROGRAM_IRRADIANCE, PROGRAM_PREFILTERED, PROGRAM_BRDF, PROGRAM_BACKGROUND,
+                    PROGRAM_QUAD_TEXTURE, PROGRAM_COUNT};
+
+QOpenGLShaderProgram *createShaderProgram(shaderProgram program);
+
+class ShaderWarmup: public QObject
+{
+    Q_OBJECT
+public:
+    static ShaderWarmup *instance();
+    void start();
+    bool isReady() const;
+signals:
+    void ready();
+private slots:
+    void finish();
+private:
+    friend class ShaderWarmupThread;
+    ShaderWarmup();
+    bool takeProgram(int &index);
+    void threadFinished();
+    QList<QOffscreenSurface*> m_surfaces;
+    QMutex m_mutex;
+    int m_nextProgram = 0;
+    int m_runningThreads = 0;
+    QAtomicInt m_ready = 0;
+    QElapsedTimer m_timer;
+};
+
+#endif // SHADERWARMUP_H
@@ -29,17 +29,12 @@ Socket::Socket(QQuickItem *parent):QQuickItem (parent)
 {
     setAcceptedMouseButtons(Qt::AllButtons);
     setAcceptHoverEvents(true);
-    view = new QQuickView();
-    view->setSource(QUrl(QStringLiteral("qrc:/qml/Socket.qml")));
-    grSocket = qobject_cast<QQuickItem *>(view->rootObject());
-    grSocket->setParentItem(this);
     m_id = QUuid::createUuid();
 }
 
 Socket::~Socket() {
     edges.clear();
     delete grSocket;
-    delete view;   
 }
 
 socketType Socket::type() const {
@@ -48,7 +43,7 @@ socketType Socket::type() const {
 
 void Socket::setType(socketType t) {
     m_type = t;
-    grSocket->setProperty("type", m_type);
+    if(grSocket) grSocket->setProperty("type", m_type);
 }
 
 int Socket::countEdge() {
@@ -60,37 +55,48 @@ QList<Edge*> Socket::getEdges() const {
 }
 
 void Socket::addEdge(Edge *edge) {    
-    if(grSocket->property("additional").toBool())  {
+    if(m_additional)  {
         edge->setVisible(isVisible());
     }
     if(edges.contains(edge)) return;
     edges.append(edge);
+    if(m_type == INPUTS) invalidateOutputHash();
 }
 
 void Socket::deleteEdge(Edge *edge) {
     edges.removeOne(edge);
+    if(m_type == INPUTS) invalidateOutputHash();
     if(m_type == INPUTS) setValue(0);
 }
 
+void Socket::invalidateOutputHash() {
+    Scene *scene = Scene::sceneOf(this);
+    Node *node = qobject_cast<Node*>(parentItem());
+    if(!scene) return;
+    scene->edgesChanged();
+    if(node) scene->invalidateOutputHash(node);
+}
+
 QVector2D Socket::globalPos() {
-    return m_globalPos;
+    QPointF pos = parentItem()->position() + QPointF(x() + width()*0.5, y() + height()*0.5);
+    return QVector2D(pos.x(), pos.y());
 }
 
-void Socket::setGlobalPos(QVector2D pos) {
-    m_globalPos = pos;
-    emit globalPosChanged(m_globalPos);
+void Socket::updateGlobalPos() {
+    if(receivers(SIGNAL(globalPosChanged(QVector2D))) == 0) return;
+    emit globalPosChanged(globalPos());
 }
 
 void Socket::hoverEnterEvent(QHoverEvent *event) {
-    grSocket->setProperty("showTip", true);
+    if(grSocket) grSocket->setProperty("showTip", true);
 }
 
 void Socket::hoverLeaveEvent(QHoverEvent *event) {
-     grSocket->setProperty("showTip", false);
+    if(grSocket) grSocket->setProperty("showTip", false);
 }
 
 void Socket::mousePressEvent(QMouseEvent *event) {
-    Scene *scene = reinterpret_cast<Scene*>(parentItem()->parentItem());
+    Scene *scene = Scene::sceneOf(this);
     if(event->button() == Qt::LeftButton && !scene->isEdgeDrag) {
         scene->isEdgeDrag = true;
         scene->startSocket = this;
@@ -100,10 +106,10 @@ void Socket::mousePressEvent(QMouseEvent *event) {
             disconnect(this, &Socket::globalPosChanged, scene->dragEdge, &Edge::setEndPosition);
         }
         else {
-            Edge *edge = new Edge(scene);
+            Edge *edge = new Edge(scene->canvas());
             scene->dragEdge = edge;
-            edge->setStartPosition(m_globalPos);
-            edge->setEndPosition(m_globalPos);
+            edge->setStartPosition(globalPos());
+            edge->setEndPosition(globalPos());
             if(output) {
                 scene->dragEdge->setStartSocket(this);
             }
@@ -115,9 +121,9 @@ void Socket::mousePressEvent(QMouseEvent *event) {
 }
 
 void Socket::mouseMoveEvent(QMouseEvent *event) {
-    Scene *scene = reinterpret_cast<Scene*>(parentItem()->parentItem());
+    Scene *scene = Scene::sceneOf(this);
     if(event->buttons() == Qt::LeftButton && scene->isEdgeDrag) {
-        QPointF globalPos = mapToItem(scene, QPointF(event->pos().x(), event->pos().y()));
+        QPointF globalPos = mapToItem(scene->canvas(), QPointF(event->pos().x(), event->pos().y()));
         if(scene->startSocket->type() == OUTPUTS || scene->startSocket->edges.count() > 0) {
             scene->dragEdge->setEndPosition(QVector2D(globalPos.x(), globalPos.y()));
         }
@@ -128,7 +134,7 @@ void Socket::mouseMoveEvent(QMouseEvent *event) {
 }
 
 void Socket::mouseReleaseEvent(QMouseEvent *event) {
-    Scene *scene = reinterpret_cast<Scene*>(parentItem()->parentItem());
+    Scene *scene = Scene::sceneOf(this);
     if(event->button() == Qt::LeftButton && scene->isEdgeDrag) {
         bool dragAccepted = false;
         bool connectedNodes = false;
@@ -230,19 +236,22 @@ void Socket::deserialize(const QJsonObject &json) {
 
 void Socket::setTip(QString text) {
     textTip = text;
+    if(!grSocket) return;
     grSocket->setProperty("textTip", textTip);
     if(textTip == "Mask") grSocket->setProperty("mask", true);
 }
 
 void Socket::setAdditional(bool additional) {
-    grSocket->setProperty("additional", additional);
+    m_additional = additional;
+    if(grSocket) grSocket->setProperty("additional", additional);
 }
 
 void Socket::setValue(const QVariant &value) {
     m_value = value;
+    valueChanged();
     if(m_type == INPUTS) {
         Node *node = qobject_cast<Node*>(parentItem());
-        node->operation();
+        node->requestOperation();
     }
     else {
         for(auto edge: edges) {
@@ -267,5 +276,22 @@ void Socket::updateScale(float scale) {
     m_scale = scale;
     setWidth(16*scale);
     setHeight(16*scale);
-    grSocket->setProperty("scaleView", scale);
+    if(grSocket) grSocket->setProperty("scaleView", scale);
+}
+
+void Socket::setDetailed(bool detailed) {
+    if(detailed == (grSocket != nullptr)) return;
+    if(detailed) {
+        grSocket = createItem(QUrl(QStringLiteral("qrc:/qml/Socket.qml")), this);
+        if(!grSocket) return;
+        grSocket->setProperty("type", m_type);
+        grSocket->setProperty("textTip", textTip);
+        grSocket->setProperty("mask", textTip == "Mask");
+        grSocket->setProperty("additional", m_additional);
+        grSocket->setProperty("scaleView", m_scale);
+    }
+    else {
+        delete grSocket;
+        grSocket = nullptr;
+    }
 }
@@ -22,7 +22,7 @@
 #ifndef SOCKET_H
 #define SOCKET_H
 #include <QQuickItem>
-#include <QQuickView>
+#include "components.h"
 #include <QJsonObject>
 #include <QUuid>
 #include "edge.h"
@@ -32,7 +32,7 @@ enum socketType {INPUTS, OUTPUTS};
 class Socket:public QQuickItem
 {
     Q_OBJECT
-    Q_PROPERTY(QVector2D globalPos READ globalPos WRITE setGlobalPos NOTIFY globalPosChanged)
+    Q_PROPERTY(QVector2D globalPos READ globalPos NOTIFY globalPosChanged)
 public:
     Socket(QQuickItem *parent);
     ~Socket();
@@ -43,7 +43,7 @@ public:
     void addEdge(Edge *edge);
     void deleteEdge(Edge *edge);
     QVector2D globalPos();
-    void setGlobalPos(QVector2D pos);
+    void updateGlobalPos();
     void mousePressEvent(QMouseEvent *event);
     void mouseMoveEvent(QMouseEvent *event);
     void mouseReleaseEvent(QMouseEvent *event);
@@ -58,15 +58,17 @@ public:
     QUuid id();
     void reset();
     void updateScale(float scale);
+    void setDetailed(bool detailed);
 signals:
     void globalPosChanged(QVector2D pos);
+    void valueChanged();
 private:
+    void invalidateOutputHash();
     QVariant m_value = 0;
-    QQuickView *view;
-    QQuickItem *grSocket;
+    QQuickItem *grSocket = nullptr;
     socketType m_type;
+    bool m_additional = false;
     QList<Edge*> edges;
-    QVector2D m_globalPos;
     float m_scale = 1.0f;
     QString textTip = "Socket";
     QUuid m_id;
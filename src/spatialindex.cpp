@@ -0,0 +1,111 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "spatialindex.h"
+#include <cmath>
+#include <algorithm>
+
+SpatialIndex::SpatialIndex(float cellSize): m_cellSize(cellSize)
+{
+}
+
+void SpatialIndex::insert(QQuickItem *item, QRectF bounds) {
+    QRect cells = cellRange(bounds);
+    auto it = m_entries.find(item);
+    if(it != m_entries.end()) {
+        it->bounds = bounds;
+        if(it->cells == cells) return;
+        for(int x = it->cells.left(); x <= it->cells.right(); ++x) {
+            for(int y = it->cells.top(); y <= it->cells.bottom(); ++y) {
+                quint64 key = cellKey(x, y);
+                m_cells[key].removeOne(item);
+                if(m_cells[key].isEmpty()) m_cells.remove(key);
+            }
+        }
+        it->cells = cells;
+    }
+    else {
+        m_entries.insert(item, {bounds, cells, m_order++});
+    }
+    for(int x = cells.left(); x <= cells.right(); ++x) {
+        for(int y = cells.top(); y <= cells.bottom(); ++y) {
+            m_cells[cellKey(x, y)].append(item);
+        }
+    }
+}
+
+void SpatialIndex::remove(QQuickItem *item) {
+    auto it = m_entries.find(item);
+    if(it == m_entries.end()) return;
+    for(int x = it->cells.left(); x <= it->cells.right(); ++x) {
+        for(int y = it->cells.top(); y <= it->cells.bottom(); ++y) {
+            quint64 key = cellKey(x, y);
+            m_cells[key].removeOne(item);
+            if(m_cells[key].isEmpty()) m_cells.remove(key);
+        }
+    }
+    m_entries.erase(it);
+}
+
+bool SpatialIndex::contains(QQuickItem *item) const {
+    return m_entries.contains(item);
+}
+
+QList<QQuickItem*> SpatialIndex::query(QRectF area) const {
+    QRect cells = cellRange(area);
+    QVector<QPair<quint64, QQuickItem*>> found;
+    for(int x = cells.left(); x <= cells.right(); ++x) {
+        for(int y = cells.top(); y <= cells.bottom(); ++y) {
+            auto cell = m_cells.find(cellKey(x, y));
+            if(cell == m_cells.end()) continue;
+            for(QQuickItem *item: *cell) {
+                const Entry &entry = *m_entries.constFind(item);
+                if(entry.bounds.right() < area.left() || entry.bounds.left() > area.right() ||
+                   entry.bounds.bottom() < area.top() || entry.bounds.top() > area.bottom()) continue;
+                found.append(qMakePair(entry.order, item));
+            }
+        }
+    }
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    QList<QQuickItem*> items;
+    for(auto &f: found) {
+        items.append(f.second);
+    }
+    return items;
+}
+
+void SpatialIndex::clear() {
+    m_cells.clear();
+    m_entries.clear();
+}
+
+QRect SpatialIndex::cellRange(QRectF bounds) const {
+    int left = static_cast<int>(std::floor(bounds.left()/m_cellSize));
+    int top = static_cast<int>(std::floor(bounds.top()/m_cellSize));
+    int right = static_cast<int>(std::floor(bounds.right()/m_cellSize));
+    int bottom = static_cast<int>(std::floor(bounds.bottom()/m_cellSize));
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+quint64 SpatialIndex::cellKey(int x, int y) {
+    return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <QQuickItem>
+#include <QHash>
+#include <QRectF>
+
+class SpatialIndex
+{
+public:
+    SpatialIndex(float cellSize = 256.0f);
+    void insert(QQuickItem *item, QRectF bounds);
+    void remove(QQuickItem *item);
+    bool contains(QQuickItem *item) const;
+    QList<QQuickItem*> query(QRectF area) const;
+    void clear();
+private:
+    struct Entry {
+        QRectF bounds;
+        QRect cells;
+        quint64 order;
+    };
+    QRect cellRange(QRectF bounds) const;
+    static quint64 cellKey(int x, int y);
+    float m_cellSize;
+    quint64 m_order = 0;
+    QHash<quint64, QVector<QQuickItem*>> m_cells;
+    QHash<QQuickItem*, Entry> m_entries;
+};
+
+#endif // SPATIALINDEX_H
@@ -26,13 +26,15 @@ Tab::Tab(QQuickItem *parent): QQuickItem (parent)
 {
     m_scene = new Scene(parent);
     connect(m_scene, &Scene::fileNameUpdate, this, &Tab::setTitle);
+    connect(m_scene, &Scene::loadProgress, this, &Tab::setLoadProgress);
     setAcceptedMouseButtons(Qt::AllButtons);
     setWidth(24);
     setHeight(25);
-    view = new QQuickView();
-    view->setSource(QUrl(QStringLiteral("qrc:/qml/TabRect.qml")));
-    grTab = qobject_cast<QQuickItem *>(view->rootObject());
-    grTab->setParentItem(this);
+    grTab = createItem(QUrl(QStringLiteral("qrc:/qml/TabRect.qml")), this);
+    if(!grTab) {
+        grTab = new QQuickItem(this);
+        return;
+    }
     connect(grTab, SIGNAL(activated()), this, SLOT(activate()));
     connect(grTab, SIGNAL(closed()), this, SLOT(close()));
 }
@@ -40,7 +42,6 @@ Tab::Tab(QQuickItem *parent): QQuickItem (parent)
 Tab::~Tab() {
     delete m_scene;
     delete grTab;
-    delete view;
 }
 
 Scene *Tab::scene() {
@@ -58,6 +59,7 @@ void Tab::activate() {
 }
 
 void Tab::close() {
+    if(m_scene->loading()) return;
     emit closedTab(this);
 }
 
@@ -70,3 +72,7 @@ void Tab::setTitle(QString fileName, bool modified) {
     }
     grTab->setProperty("fileName", title);
 }
+
+void Tab::setLoadProgress(int value, int total) {
+    grTab->setProperty("progress", total > 0 ? float(value)/total : 1.0f);
+}
@@ -22,7 +22,7 @@
 #ifndef TAB_H
 #define TAB_H
 #include <QQuickItem>
-#include <QQuickView>
+#include "components.h"
 #include "scene.h"
 
 class Tab: public QQuickItem
@@ -35,6 +35,7 @@ public:
     Scene *scene();    
     void setTitle(QString fileName, bool modified);
     void setSelected(bool select);
+    void setLoadProgress(int value, int total);
 public slots:
     void activate();
     void close();
@@ -44,7 +45,6 @@ signals:
     void movedTab(Tab *tab, int index);
 private:
     Scene *m_scene = nullptr;
-    QQuickView *view;
     QQuickItem *grTab;
     float dragX = 0.0f;
     float dragY = 0.0f;
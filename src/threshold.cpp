@@ -20,11 +20,11 @@
  */
 
 #include "threshold.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include "FreeImage.h"
 
 ThresholdObject::ThresholdObject(QQuickItem *parent, QVector2D resolution, float threshold):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_threshold(threshold)
+    ThumbnailObject(parent), m_resolution(resolution), m_threshold(threshold)
 {
 
 }
@@ -90,18 +90,9 @@ void ThresholdObject::setResolution(QVector2D res) {
 
 ThresholdRenderer::ThresholdRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    thresholdShader = new QOpenGLShaderProgram();
-    thresholdShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    thresholdShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/threshold.frag");
-    thresholdShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    thresholdShader = createShaderProgram(PROGRAM_THRESHOLD);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     thresholdShader->bind();
     thresholdShader->setUniformValue(thresholdShader->uniformLocation("sourceTexture"), 0);
     thresholdShader->setUniformValue(thresholdShader->uniformLocation("maskTexture"), 1);
@@ -146,14 +137,8 @@ ThresholdRenderer::~ThresholdRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *ThresholdRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void ThresholdRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     ThresholdObject *thresholdItem = static_cast<ThresholdObject*>(item);
     if(thresholdItem->resUpdated) {
         thresholdItem->resUpdated = false;
@@ -180,7 +165,7 @@ void ThresholdRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void ThresholdRenderer::render() {
+void ThresholdRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -22,11 +22,11 @@
 #ifndef THRESHOLD_H
 #define THRESHOLD_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 
-class ThresholdObject: public QQuickFramebufferObject
+class ThresholdObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -59,13 +59,12 @@ private:
     float m_threshold = 0.5f;
 };
 
-class ThresholdRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class ThresholdRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     ThresholdRenderer(QVector2D res);
     ~ThresholdRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void create();
     void updateTexResolution();
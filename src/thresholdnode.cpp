@@ -37,12 +37,7 @@ ThresholdNode::ThresholdNode(QQuickItem *parent, QVector2D resolution, float thr
     connect(preview, &ThresholdObject::updatePreview, this, &Node::updatePreview);
     connect(preview, &ThresholdObject::textureChanged, this, &ThresholdNode::setOutput);
     connect(this, &ThresholdNode::thresholdChanged, preview, &ThresholdObject::setThreshold);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/ThresholdProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    propertiesPanel->setProperty("startThreshold", m_threshold);
-    connect(propertiesPanel, SIGNAL(thresholdChanged(qreal)), this, SLOT(updateThreshold(qreal)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/ThresholdProperty.qml"));
     createSockets(2, 1);
     setTitle("Threshold");
     m_socketsInput[0]->setTip("Texture");
@@ -53,6 +48,11 @@ ThresholdNode::~ThresholdNode() {
     delete preview;
 }
 
+void ThresholdNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startThreshold", m_threshold);
+    connect(propertiesPanel, SIGNAL(thresholdChanged(qreal)), this, SLOT(updateThreshold(qreal)));
+}
+
 void ThresholdNode::operation() {
     preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
     preview->setMaskTexture(m_socketsInput[1]->value().toUInt());
@@ -77,7 +77,6 @@ void ThresholdNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *>
     Node::deserialize(json, hash);
     if(json.contains("threshold")) {
         updateThreshold(json["threshold"].toVariant().toReal());
-        propertiesPanel->setProperty("startThreshold", m_threshold);
     }
 }
 
@@ -45,6 +45,8 @@ public slots:
     void previewGenerated();
     void setOutput();
     void updateThreshold(qreal value);
+protected:
+    void setupPropertyPanel();
 private:
     ThresholdObject *preview;
     float m_threshold = 0.5f;
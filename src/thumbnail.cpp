@@ -0,0 +1,352 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "thumbnail.h"
+#include "shaderwarmup.h"
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOpenGLExtraFunctions>
+#include <QQuickWindow>
+
+const int slotStride = thumbnailSize + 2;
+const int slotsPerRow = thumbnailPageSize/slotStride;
+const int slotsPerPage = slotsPerRow*slotsPerRow;
+
+ThumbnailAtlas *ThumbnailAtlas::instance() {
+    // created lazily on the render thread, all thumbnails share its pages
+    static ThumbnailAtlas *atlas = new ThumbnailAtlas();
+    return atlas;
+}
+
+ThumbnailAtlas::ThumbnailAtlas() {
+    initializeOpenGLFunctions();
+}
+
+int ThumbnailAtlas::allocate() {
+    if(m_freeSlots.isEmpty()) addPage();
+    return m_freeSlots.takeLast();
+}
+
+void ThumbnailAtlas::release(int slot) {
+    if(slot >= 0) m_freeSlots.append(slot);
+}
+
+unsigned int ThumbnailAtlas::texture(int slot) {
+    return m_textures[slot/slotsPerPage];
+}
+
+unsigned int ThumbnailAtlas::framebuffer(int slot) {
+    return m_framebuffers[slot/slotsPerPage];
+}
+
+QRect ThumbnailAtlas::slotRect(int slot) {
+    int index = slot%slotsPerPage;
+    return QRect((index%slotsPerRow)*slotStride + 1, (index/slotsPerRow)*slotStride + 1, thumbnailSize, thumbnailSize);
+}
+
+void ThumbnailAtlas::addPage() {
+    int page = m_textures.size();
+    unsigned int texture, fbo;
+    int previousFBO;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, thumbnailPageSize, thumbnailPageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+    m_textures.append(texture);
+    m_framebuffers.append(fbo);
+    for(int i = slotsPerPage - 1; i >= 0; --i) {
+        m_freeSlots.append(page*slotsPerPage + i);
+    }
+}
+
+ThumbnailNode::ThumbnailNode(): slot(ThumbnailAtlas::instance()->allocate()) {
+    // the framebuffer node of QQuickFramebufferObject is kept only to drive the renderer,
+    // it gets an empty rect instead of zero opacity so its preprocess is not blocked
+    hiddenNode = new QSGNode();
+    appendChildNode(hiddenNode);
+}
+
+ThumbnailNode::~ThumbnailNode() {
+    ThumbnailAtlas::instance()->release(slot);
+}
+
+ThumbnailObject::ThumbnailObject(QQuickItem *parent): QQuickFramebufferObject(parent)
+{
+    ShaderWarmup *warmup = ShaderWarmup::instance();
+    if(!warmup->isReady()) connect(warmup, &ShaderWarmup::ready, this, &QQuickItem::update);
+}
+
+int ThumbnailObject::slot() {
+    return m_slot;
+}
+
+bool ThumbnailObject::thumbnailVisible() {
+    return m_thumbnailVisible;
+}
+
+void ThumbnailObject::setThumbnailVisible(bool visible) {
+    if(m_thumbnailVisible == visible) return;
+    m_thumbnailVisible = visible;
+    update();
+}
+
+void ThumbnailObject::requestOutput(unsigned int texture, bool pixels) {
+    // without pixels the capture only reports that the output has been drawn,
+    // a pending request that wants them keeps them
+    m_outputPixels = pixels || (m_outputRequest && m_outputPixels);
+    m_outputRequest = texture;
+    update();
+}
+
+void ThumbnailObject::restoreOutput(QByteArray data, QSize size) {
+    m_restoreData = data;
+    m_restoreSize = size;
+    m_outputRestored = true;
+    update();
+}
+
+void ThumbnailObject::detachRestoreData() {
+    // pixels waiting for the next synchronize may point into a file mapping that is about to close
+    if(!m_restoreData.isEmpty()) m_restoreData.detach();
+}
+
+void ThumbnailObject::copyOutput(unsigned int texture) {
+    m_copyRequest = texture;
+    m_outputRestored = true;
+    update();
+}
+
+void ThumbnailObject::setOutputRestored(bool restored) {
+    if(m_outputRestored == restored) return;
+    m_outputRestored = restored;
+    update();
+}
+
+QSGNode *ThumbnailObject::updatePaintNode(QSGNode *node, UpdatePaintNodeData *data) {
+    ThumbnailNode *n = static_cast<ThumbnailNode*>(node);
+    if(!n && (width() <= 0 || height() <= 0)) return nullptr;
+    if(!n) {
+        n = new ThumbnailNode();
+        ThumbnailAtlas *atlas = ThumbnailAtlas::instance();
+        n->setTexture(window()->createTextureFromId(atlas->texture(n->slot), QSize(thumbnailPageSize, thumbnailPageSize),
+                                                    QQuickWindow::TextureHasAlphaChannel));
+        n->setOwnsTexture(true);
+        n->setSourceRect(atlas->slotRect(n->slot));
+        n->setFiltering(QSGTexture::Linear);
+    }
+    m_slot = n->slot;
+    QSGNode *fboNode = n->hiddenNode->firstChild();
+    QSGNode *updated = QQuickFramebufferObject::updatePaintNode(fboNode, data);
+    if(updated) {
+        static_cast<QSGSimpleTextureNode*>(updated)->setRect(QRectF());
+        if(!fboNode) n->hiddenNode->appendChildNode(updated);
+    }
+    // keeps synchronizing until the renderer has handed over a pending readback
+    if(m_capturing) update();
+    // the renderer still evaluates, restores and captures before the warm-up is done,
+    // only the thumbnail keeps its empty placeholder body until then
+    bool shown = m_thumbnailVisible && ShaderWarmup::instance()->isReady();
+    n->setRect(shown ? boundingRect() : QRectF());
+    return n;
+}
+
+ThumbnailRenderer::~ThumbnailRenderer() {
+    releaseRestored();
+    QOpenGLExtraFunctions *f = QOpenGLContext::currentContext()->extraFunctions();
+    if(m_captureFence) f->glDeleteSync(m_captureFence);
+    f->glDeleteBuffers(1, &m_captureBuffer);
+}
+
+QOpenGLFramebufferObject *ThumbnailRenderer::createFramebufferObject(const QSize &size) {
+    Q_UNUSED(size)
+    return new QOpenGLFramebufferObject(1, 1);
+}
+
+void ThumbnailRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailObject *thumbnail = static_cast<ThumbnailObject*>(item);
+    m_slot = thumbnail->slot();
+    m_visible = thumbnail->thumbnailVisible();
+    if(m_capturePending) deliverCapture(thumbnail);
+    if(thumbnail->m_outputRequest) {
+        // read back in render(), after the derived renderer has drawn this frame's output
+        m_captureRequest = thumbnail->m_outputRequest;
+        m_capturePixels = thumbnail->m_outputPixels;
+        thumbnail->m_outputRequest = 0;
+    }
+    thumbnail->m_capturing = m_capturePending || m_captureRequest;
+    if(!thumbnail->m_restoreData.isEmpty()) {
+        uploadRestored(thumbnail->m_restoreData, thumbnail->m_restoreSize);
+        thumbnail->m_restoreData.clear();
+        thumbnail->outputRestored(m_restoredTexture);
+    }
+    else if(thumbnail->m_copyRequest) {
+        bool copied = copyRestored(thumbnail->m_copyRequest);
+        thumbnail->m_copyRequest = 0;
+        thumbnail->outputRestored(copied ? m_restoredTexture : 0);
+    }
+    m_restored = thumbnail->m_outputRestored;
+    if(!m_restored) releaseRestored();
+}
+
+void ThumbnailRenderer::render() {
+    if(m_captureRequest && !m_capturePending) {
+        captureOutput(m_captureRequest, m_capturePixels);
+        m_captureRequest = 0;
+    }
+    if(m_slot < 0 || !m_visible) return;
+    ThumbnailAtlas *atlas = ThumbnailAtlas::instance();
+    QRect rect = atlas->slotRect(m_slot);
+    QOpenGLExtraFunctions *f = QOpenGLContext::currentContext()->extraFunctions();
+    if(m_restored && m_restoredFramebuffer) {
+        f->glBindFramebuffer(GL_READ_FRAMEBUFFER, m_restoredFramebuffer);
+        f->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, atlas->framebuffer(m_slot));
+        f->glBlitFramebuffer(0, 0, m_restoredSize.width(), m_restoredSize.height(),
+                             rect.x(), rect.y(), rect.right() + 1, rect.bottom() + 1, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        framebufferObject()->bind();
+        return;
+    }
+    f->glBindFramebuffer(GL_FRAMEBUFFER, atlas->framebuffer(m_slot));
+    f->glViewport(rect.x(), rect.y(), rect.width(), rect.height());
+    f->glScissor(rect.x(), rect.y(), rect.width(), rect.height());
+    f->glEnable(GL_SCISSOR_TEST);
+    renderPreview();
+    f->glDisable(GL_SCISSOR_TEST);
+    framebufferObject()->bind();
+}
+
+void ThumbnailRenderer::captureOutput(unsigned int texture, bool pixels) {
+    // the pixels are read into a pixel buffer and handed over by a later synchronize
+    // once the fence has passed, so the readback doesn't stall the render thread
+    QOpenGLExtraFunctions *f = QOpenGLContext::currentContext()->extraFunctions();
+    int width = 0, height = 0, previousFBO;
+    f->glBindTexture(GL_TEXTURE_2D, texture);
+    f->glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+    f->glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+    f->glBindTexture(GL_TEXTURE_2D, 0);
+    m_capturePending = true;
+    m_captureSize = pixels ? QSize(width, height) : QSize();
+    if(m_captureSize.isEmpty()) return;
+    if(!m_captureBuffer) f->glGenBuffers(1, &m_captureBuffer);
+    f->glBindBuffer(GL_PIXEL_PACK_BUFFER, m_captureBuffer);
+    f->glBufferData(GL_PIXEL_PACK_BUFFER, 4*width*height, nullptr, GL_STREAM_READ);
+    unsigned int fbo;
+    f->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+    f->glGenFramebuffers(1, &fbo);
+    f->glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    f->glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    f->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    f->glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    f->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    f->glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+    f->glDeleteFramebuffers(1, &fbo);
+    m_captureFence = f->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void ThumbnailRenderer::deliverCapture(ThumbnailObject *thumbnail) {
+    QOpenGLExtraFunctions *f = QOpenGLContext::currentContext()->extraFunctions();
+    if(m_captureFence) {
+        if(f->glClientWaitSync(m_captureFence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) return;
+        f->glDeleteSync(m_captureFence);
+        m_captureFence = nullptr;
+    }
+    m_capturePending = false;
+    if(m_captureSize.isEmpty()) {
+        thumbnail->outputCaptured(QByteArray(), QSize());
+        return;
+    }
+    int size = 4*m_captureSize.width()*m_captureSize.height();
+    f->glBindBuffer(GL_PIXEL_PACK_BUFFER, m_captureBuffer);
+    void *pixels = f->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    QByteArray data;
+    if(pixels) {
+        data = QByteArray(static_cast<const char*>(pixels), size);
+        f->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    f->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    thumbnail->outputCaptured(data, data.isEmpty() ? QSize() : m_captureSize);
+}
+
+void ThumbnailRenderer::uploadRestored(QByteArray data, QSize size) {
+    QOpenGLExtraFunctions *f = QOpenGLContext::currentContext()->extraFunctions();
+    int previousFBO;
+    if(!m_restoredTexture) {
+        f->glGenTextures(1, &m_restoredTexture);
+        f->glGenFramebuffers(1, &m_restoredFramebuffer);
+    }
+    m_restoredSize = size;
+    f->glBindTexture(GL_TEXTURE_2D, m_restoredTexture);
+    f->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    f->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size.width(), size.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                    data.isEmpty() ? nullptr : data.constData());
+    f->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    f->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    f->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    f->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    f->glBindTexture(GL_TEXTURE_2D, 0);
+    f->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+    f->glBindFramebuffer(GL_FRAMEBUFFER, m_restoredFramebuffer);
+    f->glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_restoredTexture, 0);
+    f->glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+}
+
+bool ThumbnailRenderer::copyRestored(unsigned int texture) {
+    // the copy stays on the GPU, the source output is blitted into a texture of its own
+    // so it outlives the node it was copied from
+    QOpenGLExtraFunctions *f = QOpenGLContext::currentContext()->extraFunctions();
+    int width = 0, height = 0, previousFBO;
+    f->glBindTexture(GL_TEXTURE_2D, texture);
+    f->glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+    f->glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+    f->glBindTexture(GL_TEXTURE_2D, 0);
+    if(width <= 0 || height <= 0) return false;
+    uploadRestored(QByteArray(), QSize(width, height));
+    unsigned int fbo;
+    f->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+    f->glGenFramebuffers(1, &fbo);
+    f->glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    f->glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    f->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_restoredFramebuffer);
+    f->glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    f->glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+    f->glDeleteFramebuffers(1, &fbo);
+    return true;
+}
+
+void ThumbnailRenderer::releaseRestored() {
+    if(!m_restoredTexture) return;
+    QOpenGLExtraFunctions *f = QOpenGLContext::currentContext()->extraFunctions();
+    f->glDeleteFramebuffers(1, &m_restoredFramebuffer);
+    f->glDeleteTextures(1, &m_restoredTexture);
+    m_restoredFramebuffer = 0;
+    m_restoredTexture = 0;
+}
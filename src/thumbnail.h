@@ -0,0 +1,118 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef THUMBNAIL_H
+#define THUMBNAIL_H
+
+#include <QQuickFramebufferObject>
+#include <QOpenGLFunctions_4_4_Core>
+#include <QSGSimpleTextureNode>
+
+const int thumbnailSize = 174;
+const int thumbnailPageSize = 2048;
+
+class ThumbnailAtlas: protected QOpenGLFunctions_4_4_Core
+{
+public:
+    static ThumbnailAtlas *instance();
+    int allocate();
+    void release(int slot);
+    unsigned int texture(int slot);
+    unsigned int framebuffer(int slot);
+    QRect slotRect(int slot);
+private:
+    ThumbnailAtlas();
+    void addPage();
+    QVector<unsigned int> m_textures;
+    QVector<unsigned int> m_framebuffers;
+    QVector<int> m_freeSlots;
+};
+
+class ThumbnailNode: public QSGSimpleTextureNode
+{
+public:
+    ThumbnailNode();
+    ~ThumbnailNode();
+    int slot;
+    QSGNode *hiddenNode;
+};
+
+class ThumbnailObject: public QQuickFramebufferObject
+{
+    Q_OBJECT
+public:
+    ThumbnailObject(QQuickItem *parent = nullptr);
+    int slot();
+    bool thumbnailVisible();
+    void setThumbnailVisible(bool visible);
+    void requestOutput(unsigned int texture, bool pixels = true);
+    void restoreOutput(QByteArray data, QSize size);
+    void detachRestoreData();
+    void copyOutput(unsigned int texture);
+    void setOutputRestored(bool restored);
+signals:
+    void outputCaptured(QByteArray data, QSize size);
+    void outputRestored(unsigned int texture);
+protected:
+    QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *data);
+private:
+    friend class ThumbnailRenderer;
+    int m_slot = -1;
+    bool m_thumbnailVisible = false;
+    unsigned int m_outputRequest = 0;
+    bool m_outputPixels = true;
+    QByteArray m_restoreData;
+    QSize m_restoreSize;
+    unsigned int m_copyRequest = 0;
+    bool m_outputRestored = false;
+    bool m_capturing = false;
+};
+
+class ThumbnailRenderer: public QQuickFramebufferObject::Renderer
+{
+public:
+    ~ThumbnailRenderer();
+    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
+    void synchronize(QQuickFramebufferObject *item);
+    void render();
+protected:
+    virtual void renderPreview() = 0;
+private:
+    void captureOutput(unsigned int texture, bool pixels);
+    void deliverCapture(ThumbnailObject *thumbnail);
+    void uploadRestored(QByteArray data, QSize size);
+    bool copyRestored(unsigned int texture);
+    void releaseRestored();
+    int m_slot = -1;
+    bool m_visible = false;
+    bool m_restored = false;
+    unsigned int m_restoredTexture = 0;
+    unsigned int m_restoredFramebuffer = 0;
+    QSize m_restoredSize;
+    unsigned int m_captureRequest = 0;
+    bool m_capturePixels = true;
+    unsigned int m_captureBuffer = 0;
+    GLsync m_captureFence = nullptr;
+    QSize m_captureSize;
+    bool m_capturePending = false;
+};
+
+#endif // THUMBNAIL_H
@@ -20,14 +20,17 @@
  */
 
 #include "tile.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include <iostream>
+#include <algorithm>
+#include <QtMath>
 #include "FreeImage.h"
+#include "hash.h"
 
 TileObject::TileObject(QQuickItem *parent, QVector2D resolution, float offsetX, float offsetY, int columns,
                        int rows, float scaleX, float scaleY, int rotation, float randPosition,
                        float randRotation, float randScale, float maskStrength, int inputsCount, int seed,
-                       bool keepProportion, bool useAlpha): QQuickFramebufferObject (parent),
+                       bool keepProportion, bool useAlpha): ThumbnailObject(parent),
     m_resolution(resolution), m_offsetX(offsetX), m_offsetY(offsetY), m_columns(columns), m_rows(rows),
     m_scaleX(scaleX), m_scaleY(scaleY), m_rotationAngle(rotation), m_randPosition(randPosition),
     m_randRotation(randRotation), m_randScale(randScale), m_maskStrength(maskStrength),
@@ -59,62 +62,14 @@ void TileObject::setMaskTexture(unsigned int texture) {
     update();
 }
 
-unsigned int TileObject::sourceTexture() {
-    return m_sourceTexture;
+QVector<unsigned int> TileObject::tiles() {
+    return m_tiles;
 }
 
-void TileObject::setSourceTexture(unsigned int texture) {
-    m_sourceTexture = texture;
-    tiledTex = true;
-    update();
-}
-
-unsigned int TileObject::tile1() {
-    return m_tile1;
-}
-
-void TileObject::setTile1(unsigned int texture) {
-    m_tile1 = texture;
-    tiledTex = true;
-    update();
-}
-
-unsigned int TileObject::tile2() {
-    return m_tile2;
-}
-
-void TileObject::setTile2(unsigned int texture) {
-    m_tile2 = texture;
-    tiledTex = true;
-    update();
-}
-
-unsigned int TileObject::tile3() {
-    return m_tile3;
-}
-
-void TileObject::setTile3(unsigned int texture) {
-    m_tile3 = texture;
-    tiledTex = true;
-    update();
-}
-
-unsigned int TileObject::tile4() {
-    return m_tile4;
-}
-
-void TileObject::setTile4(unsigned int texture) {
-    m_tile4 = texture;
-    tiledTex = true;
-    update();
-}
-
-unsigned int TileObject::tile5() {
-    return m_tile5;
-}
-
-void TileObject::setTile5(unsigned int texture) {
-    m_tile5 = texture;
+void TileObject::setTiles(QVector<unsigned int> tiles, QSet<int> changedTiles) {
+    m_tiles = tiles;
+    this->changedTiles.unite(changedTiles);
+    tilesUpdated = true;
     tiledTex = true;
     update();
 }
@@ -251,7 +206,7 @@ int TileObject::seed() {
 
 void TileObject::setSeed(int seed) {
     m_seed = seed;
-    randUpdated = true;
+    tiledTex = true;
     update();
 }
 
@@ -275,6 +230,16 @@ void TileObject::setUseAlpha(bool use) {
     update();
 }
 
+bool TileObject::scatter() {
+    return m_scatter;
+}
+
+void TileObject::setScatter(bool scatter) {
+    m_scatter = scatter;
+    tiledTex = true;
+    update();
+}
+
 QVector2D TileObject::resolution() {
     return m_resolution;
 }
@@ -288,40 +253,28 @@ void TileObject::setResolution(QVector2D res) {
 TileRenderer::TileRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
 
-    tileShader = new QOpenGLShaderProgram();
-    tileShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    tileShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/tile.frag");
-    tileShader->link();
+    tileShader = createShaderProgram(PROGRAM_TILE);
 
-    randomShader = new QOpenGLShaderProgram();
-    randomShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/noise.vert");
-    randomShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/random.frag");
-    randomShader->link();
+    scatterShader = createShaderProgram(PROGRAM_TILE_SCATTER);
 
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
+    maskShader = createShaderProgram(PROGRAM_TILE_MASK);
 
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
 
     tileShader->bind();
-    tileShader->setUniformValue(tileShader->uniformLocation("textureTile"), 0);
+    tileShader->setUniformValue(tileShader->uniformLocation("tiles"), 0);
     tileShader->setUniformValue(tileShader->uniformLocation("maskTexture"), 1);
-    tileShader->setUniformValue(tileShader->uniformLocation("randomTexture"), 2);
-    tileShader->setUniformValue(tileShader->uniformLocation("tile1"), 3);
-    tileShader->setUniformValue(tileShader->uniformLocation("tile2"), 4);
-    tileShader->setUniformValue(tileShader->uniformLocation("tile3"), 5);
-    tileShader->setUniformValue(tileShader->uniformLocation("tile4"), 6);
-    tileShader->setUniformValue(tileShader->uniformLocation("tile5"), 7);
     tileShader->release();
 
-    randomShader->bind();
-    randomShader->setUniformValue(randomShader->uniformLocation("seed"), 1);
-    randomShader->release();
+    scatterShader->bind();
+    scatterShader->setUniformValue(scatterShader->uniformLocation("tiles"), 0);
+    scatterShader->release();
+
+    maskShader->bind();
+    maskShader->setUniformValue(maskShader->uniformLocation("maskTexture"), 1);
+    maskShader->release();
 
     textureShader->bind();
     textureShader->setUniformValue(textureShader->uniformLocation("textureSample"), 0);
@@ -344,6 +297,27 @@ TileRenderer::TileRenderer(QVector2D res): m_resolution(res) {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
+    float corners[] = {0.0f, 0.0f,
+                       0.0f, 1.0f,
+                       1.0f, 0.0f,
+                       1.0f, 1.0f};
+    glGenVertexArrays(1, &scatterVAO);
+    glBindVertexArray(scatterVAO);
+    glGenBuffers(1, &cornersVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, cornersVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2*sizeof(float), nullptr);
+    glGenBuffers(1, &instanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for(unsigned int i = 1; i < 5; ++i) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribPointer(i, 2, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void*)(2*(i - 1)*sizeof(float)));
+        glVertexAttribDivisor(i, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
     glGenFramebuffers(1, &tileFBO);
     glBindFramebuffer(GL_FRAMEBUFFER, tileFBO);
     glGenTextures(1, &m_tiledTexture);
@@ -357,34 +331,31 @@ TileRenderer::TileRenderer(QVector2D res): m_resolution(res) {
     glBindTexture(GL_TEXTURE_2D, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    glGenFramebuffers(1, &randomFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, randomFBO);
-    glGenTextures(1, &m_randomTexture);
-    glBindTexture(GL_TEXTURE_2D, m_randomTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 512, 512, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_randomTexture, 0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glGenFramebuffers(1, &copyFBO);
+    glGenTextures(1, &tilesArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tilesArray);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 }
 
 TileRenderer::~TileRenderer() {
     delete tileShader;
+    delete scatterShader;
+    delete maskShader;
     delete checkerShader;
     delete textureShader;
-}
-
-QOpenGLFramebufferObject *TileRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
+    glDeleteVertexArrays(1, &scatterVAO);
+    glDeleteBuffers(1, &cornersVBO);
+    glDeleteBuffers(1, &instanceVBO);
+    glDeleteTextures(1, &tilesArray);
+    glDeleteFramebuffers(1, &copyFBO);
 }
 
 void TileRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     TileObject *tileItem = static_cast<TileObject*>(item);
     if(tileItem->resUpdated) {
         tileItem->resUpdated = false;
@@ -393,32 +364,53 @@ void TileRenderer::synchronize(QQuickFramebufferObject *item) {
     }
     if(tileItem->tiledTex) {
         tileItem->tiledTex = false;
-        m_sourceTexture = tileItem->sourceTexture();
-        m_tile1 = tileItem->tile1();
-        m_tile2 = tileItem->tile2();
-        m_tile3 = tileItem->tile3();
-        m_tile4 = tileItem->tile4();
-        m_tile5 = tileItem->tile5();
-        if(m_sourceTexture || m_tile1 || m_tile2 || m_tile3 || m_tile4 || m_tile5) {
+        if(tileItem->tilesUpdated) {
+            tileItem->tilesUpdated = false;
+            QVector<unsigned int> tiles = tileItem->tiles();
+            QVector<int> layers;
+            int layerCount = 0;
+            for(unsigned int tile: tiles) {
+                layers.append(tile ? layerCount++ : -1);
+            }
+            for(int i = 0; i < tiles.size(); ++i) {
+                if(layers != m_tileLayers || tiles[i] != m_tiles[i] || tileItem->changedTiles.contains(i)) {
+                    dirtyLayers.insert(i);
+                }
+            }
+            tileItem->changedTiles.clear();
+            m_tiles = tiles;
+            m_tileLayers = layers;
+        }
+        if(hasTiles()) {
+            if(!dirtyLayers.isEmpty() || !tilesLayers) updateTilesArray();
             maskTexture = tileItem->maskTexture();
-            tileShader->bind();
-            tileShader->setUniformValue(tileShader->uniformLocation("offsetX"), tileItem->offsetX());
-            tileShader->setUniformValue(tileShader->uniformLocation("offsetY"), tileItem->offsetY());
-            tileShader->setUniformValue(tileShader->uniformLocation("columns"), tileItem->columns());
-            tileShader->setUniformValue(tileShader->uniformLocation("rows"), tileItem->rows());
-            tileShader->setUniformValue(tileShader->uniformLocation("scaleX"), tileItem->scaleX());
-            tileShader->setUniformValue(tileShader->uniformLocation("scaleY"), tileItem->scaleY());
-            tileShader->setUniformValue(tileShader->uniformLocation("rotationAngle"), tileItem->rotationAngle());
-            tileShader->setUniformValue(tileShader->uniformLocation("randPosition"), tileItem->randPosition());
-            tileShader->setUniformValue(tileShader->uniformLocation("randRotation"), tileItem->randRotation());
-            tileShader->setUniformValue(tileShader->uniformLocation("randScale"), tileItem->randScale());
-            tileShader->setUniformValue(tileShader->uniformLocation("maskStrength"), tileItem->maskStrength());
-            tileShader->setUniformValue(tileShader->uniformLocation("inputCount"), tileItem->inputsCount());
-            tileShader->setUniformValue(tileShader->uniformLocation("keepProportion"), tileItem->keepProportion());
-            tileShader->setUniformValue(tileShader->uniformLocation("useAlpha"), tileItem->useAlpha());
-            tileShader->setUniformValue(tileShader->uniformLocation("useMask"), maskTexture);
-            tileShader->release();
-            createTile();
+            m_useAlpha = tileItem->useAlpha();
+            if(tileItem->scatter()) {
+                updateInstances(tileItem);
+                createScatter();
+            }
+            else {
+                tileShader->bind();
+                tileShader->setUniformValue(tileShader->uniformLocation("offsetX"), tileItem->offsetX());
+                tileShader->setUniformValue(tileShader->uniformLocation("offsetY"), tileItem->offsetY());
+                tileShader->setUniformValue(tileShader->uniformLocation("columns"), tileItem->columns());
+                tileShader->setUniformValue(tileShader->uniformLocation("rows"), tileItem->rows());
+                tileShader->setUniformValue(tileShader->uniformLocation("scaleX"), tileItem->scaleX());
+                tileShader->setUniformValue(tileShader->uniformLocation("scaleY"), tileItem->scaleY());
+                tileShader->setUniformValue(tileShader->uniformLocation("rotationAngle"), tileItem->rotationAngle());
+                tileShader->setUniformValue(tileShader->uniformLocation("randPosition"), tileItem->randPosition());
+                tileShader->setUniformValue(tileShader->uniformLocation("randRotation"), tileItem->randRotation());
+                tileShader->setUniformValue(tileShader->uniformLocation("randScale"), tileItem->randScale());
+                tileShader->setUniformValue(tileShader->uniformLocation("maskStrength"), tileItem->maskStrength());
+                tileShader->setUniformValue(tileShader->uniformLocation("inputCount"), tileItem->inputsCount());
+                tileShader->setUniformValueArray(tileShader->uniformLocation("tileLayers"), m_tileLayers.constData(), m_tileLayers.size());
+                tileShader->setUniformValue(tileShader->uniformLocation("seed"), tileItem->seed());
+                tileShader->setUniformValue(tileShader->uniformLocation("keepProportion"), tileItem->keepProportion());
+                tileShader->setUniformValue(tileShader->uniformLocation("useAlpha"), m_useAlpha);
+                tileShader->setUniformValue(tileShader->uniformLocation("useMask"), maskTexture);
+                tileShader->release();
+                createTile();
+            }
             tileItem->setTexture(m_tiledTexture);            
             tileItem->updatePreview(m_tiledTexture);
         }
@@ -426,21 +418,13 @@ void TileRenderer::synchronize(QQuickFramebufferObject *item) {
             tileItem->setTexture(0);
         }
     }
-    if(tileItem->randUpdated) {
-        tileItem->randUpdated = false;
-        randomShader->bind();
-        randomShader->setUniformValue(randomShader->uniformLocation("seed"), tileItem->seed());
-        randomShader->release();
-        createRandom();
-        createTile();
-    }
     if(tileItem->texSaving) {
         tileItem->texSaving = false;
         saveTexture(tileItem->saveName);
     }
 }
 
-void TileRenderer::render() {
+void TileRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -453,7 +437,7 @@ void TileRenderer::render() {
     glBindVertexArray(0);
     checkerShader->release();
 
-    if(m_sourceTexture || m_tile1 || m_tile2 || m_tile3 || m_tile4 || m_tile5) {
+    if(hasTiles()) {
         textureShader->bind();
         glBindVertexArray(textureVAO);
         glActiveTexture(GL_TEXTURE0);
@@ -473,46 +457,177 @@ void TileRenderer::createTile() {
     glBindVertexArray(textureVAO);
     tileShader->bind();
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_sourceTexture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tilesArray);
     glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, maskTexture);
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, m_randomTexture);
-    glActiveTexture(GL_TEXTURE3);
-    glBindTexture(GL_TEXTURE_2D, m_tile1);
-    glActiveTexture(GL_TEXTURE4);
-    glBindTexture(GL_TEXTURE_2D, m_tile2);
-    glActiveTexture(GL_TEXTURE5);
-    glBindTexture(GL_TEXTURE_2D, m_tile3);
-    glActiveTexture(GL_TEXTURE6);
-    glBindTexture(GL_TEXTURE_2D, m_tile4);
-    glActiveTexture(GL_TEXTURE7);
-    glBindTexture(GL_TEXTURE_2D, m_tile5);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     tileShader->release();
     glBindVertexArray(0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-void TileRenderer::createRandom() {
-    glBindFramebuffer(GL_FRAMEBUFFER, randomFBO);
-    glViewport(0, 0, 512, 512);
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+void TileRenderer::createScatter() {
+    glBindFramebuffer(GL_FRAMEBUFFER, tileFBO);
+    glViewport(0, 0, m_resolution.x(), m_resolution.y());
+    glClearColor(0.0f, 0.0f, 0.0f, m_useAlpha ? 0.0f : 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, m_useAlpha);
+    glBindVertexArray(scatterVAO);
+    scatterShader->bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tilesArray);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, instanceCount);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    scatterShader->release();
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    if(maskTexture) {
+        glBlendFunc(GL_ZERO, GL_SRC_COLOR);
+        glBindVertexArray(textureVAO);
+        maskShader->bind();
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, maskTexture);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE0);
+        maskShader->release();
+    }
+    glDisable(GL_BLEND);
+    glBindVertexArray(0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void TileRenderer::updateInstances(TileObject *item) {
+    int columns = item->columns();
+    int rows = item->rows();
+    QVector2D cellSize(1.0f/columns, 1.0f/rows);
+    QVector2D offsetForProportion(0.0f, 0.0f);
+    QVector2D scaleForProportion(1.0f, 1.0f);
+    if(item->keepProportion()) {
+        if(columns < rows) {
+            offsetForProportion = QVector2D(1.0f - columns/rows, 0.0f)*0.5f;
+            scaleForProportion = QVector2D(float(rows)/columns, 1.0f);
+        }
+        else {
+            offsetForProportion = QVector2D(0.0f, 1.0f - rows/columns)*0.5f;
+            scaleForProportion = QVector2D(1.0f, float(columns)/rows);
+        }
+    }
+
+    QVector<float> cells;
+    QVector<int> order;
+    cells.reserve(columns*rows*8);
+    order.reserve(columns*rows);
+    for(int y = 0; y < rows; ++y) {
+        for(int x = 0; x < columns; ++x) {
+            QVector4D random = hash42(x, y, item->seed());
+            float angle = qDegreesToRadians(float(item->rotationAngle())) + float(M_PI)*random.z()*item->randRotation();
+            float c = qCos(angle);
+            float s = qSin(angle);
+            QVector2D scale = QVector2D(item->scaleX(), item->scaleY()) - QVector2D(1.0f, 1.0f)*random.w()*item->randScale();
+            QVector2D base = QVector2D(x, y) + QVector2D((y % 2)*item->offsetX(), (x % 2)*item->offsetY()) -
+                    random.toVector2D()*item->randPosition();
+            QVector2D points[3];
+            QVector2D uvs[3] = {QVector2D(0.0f, 0.0f), QVector2D(1.0f, 0.0f), QVector2D(0.0f, 1.0f)};
+            for(int i = 0; i < 3; ++i) {
+                QVector2D d = (uvs[i] - QVector2D(0.5f, 0.5f))*scale;
+                d = QVector2D(c*d.x() + s*d.y(), -s*d.x() + c*d.y()) + QVector2D(0.5f, 0.5f);
+                if(item->keepProportion()) {
+                    d = (d - offsetForProportion)/scaleForProportion + offsetForProportion;
+                }
+                points[i] = (base + d)*cellSize;
+            }
+            float shade = 1.0f - (random.x() + random.y())*0.5f*item->maskStrength();
+            int layer = m_tileLayers.value(qFloor((random.z() + random.w())*0.5f*(item->inputsCount() - 0.1f)), -1);
+            if(layer < 0) continue;
+            order.append(order.size());
+            cells << points[0].x() << points[0].y() << (points[1] - points[0]).x() << (points[1] - points[0]).y()
+                  << (points[2] - points[0]).x() << (points[2] - points[0]).y() << shade << layer;
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&cells](int a, int b) {
+        return cells[a*8 + 6] < cells[b*8 + 6];
+    });
+
+    QVector<float> instances;
+    instances.reserve(cells.size());
+    for(int index: order) {
+        const float *cell = cells.constData() + index*8;
+        QVector2D origin(cell[0], cell[1]);
+        QVector2D axisU(cell[2], cell[3]);
+        QVector2D axisV(cell[4], cell[5]);
+        QVector2D corners[3] = {origin + axisU, origin + axisV, origin + axisU + axisV};
+        QVector2D minCorner = origin;
+        QVector2D maxCorner = origin;
+        for(int i = 0; i < 3; ++i) {
+            minCorner = QVector2D(qMin(minCorner.x(), corners[i].x()), qMin(minCorner.y(), corners[i].y()));
+            maxCorner = QVector2D(qMax(maxCorner.x(), corners[i].x()), qMax(maxCorner.y(), corners[i].y()));
+        }
+        for(int i = qFloor(-maxCorner.y()) + 1; i <= qFloor(1.0f - minCorner.y()); ++i) {
+            for(int j = qFloor(-maxCorner.x()) + 1; j <= qFloor(1.0f - minCorner.x()); ++j) {
+                instances << cell[0] + j << cell[1] + i;
+                for(int k = 2; k < 8; ++k) instances << cell[k];
+            }
+        }
+    }
+    instanceCount = instances.size()/8;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, instances.size()*sizeof(float), instances.constData(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TileRenderer::updateTilesArray() {
+    // the array holds only the connected inputs, a changed layout refills every layer
+    int layerCount = 0;
+    for(int layer: m_tileLayers) {
+        if(layer >= 0) ++layerCount;
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tilesArray);
+    if(tilesLayers != layerCount) {
+        tilesLayers = layerCount;
+        for(int i = 0; i < m_tiles.size(); ++i) dirtyLayers.insert(i);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, m_resolution.x(), m_resolution.y(), tilesLayers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, copyFBO);
+    glViewport(0, 0, m_resolution.x(), m_resolution.y());
+    glDisable(GL_BLEND);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glBindVertexArray(textureVAO);
-    randomShader->bind();
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    randomShader->release();
+    textureShader->bind();
+    glActiveTexture(GL_TEXTURE0);
+    for(int i: dirtyLayers) {
+        if(i >= m_tileLayers.size() || m_tileLayers[i] < 0) continue;
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, tilesArray, 0, m_tileLayers[i]);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glBindTexture(GL_TEXTURE_2D, m_tiles[i]);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+    dirtyLayers.clear();
+    glBindTexture(GL_TEXTURE_2D, 0);
+    textureShader->release();
     glBindVertexArray(0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+bool TileRenderer::hasTiles() {
+    for(unsigned int tile: m_tiles) {
+        if(tile) return true;
+    }
+    return false;
+}
+
 void TileRenderer::updateTexResolution() {
     glBindTexture(GL_TEXTURE_2D, m_tiledTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_resolution.x(), m_resolution.y(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glBindTexture(GL_TEXTURE_2D, 0);
+    tilesLayers = 0;
 }
 
 void TileRenderer::saveTexture(QString fileName) {
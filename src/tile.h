@@ -22,11 +22,14 @@
 #ifndef TILE_H
 #define TILE_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
+#include <QSet>
 
-class TileObject: public QQuickFramebufferObject
+const int maxTileInputs = 32;
+
+class TileObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -36,18 +39,8 @@ public:
     void setTexture(unsigned int texture);
     unsigned int maskTexture();
     void setMaskTexture(unsigned int texture);
-    unsigned int sourceTexture();
-    void setSourceTexture(unsigned int texture);
-    unsigned int tile1();
-    void setTile1(unsigned int texture);
-    unsigned int tile2();
-    void setTile2(unsigned int texture);
-    unsigned int tile3();
-    void setTile3(unsigned int texture);
-    unsigned int tile4();
-    void setTile4(unsigned int texture);
-    unsigned int tile5();
-    void setTile5(unsigned int texture);
+    QVector<unsigned int> tiles();
+    void setTiles(QVector<unsigned int> tiles, QSet<int> changedTiles);
     void saveTexture(QString fileName);
     float offsetX();
     void setOffsetX(float offset);
@@ -79,10 +72,13 @@ public:
     void setKeepProportion(bool keep);
     bool useAlpha();
     void setUseAlpha(bool use);
+    bool scatter();
+    void setScatter(bool scatter);
     QVector2D resolution();
     void setResolution(QVector2D res);
     bool tiledTex = false;
-    bool randUpdated = true;
+    bool tilesUpdated = false;
+    QSet<int> changedTiles;
     bool selectedItem = false;
     bool resUpdated = false;
     bool texSaving = false;
@@ -93,12 +89,7 @@ signals:
 private:
     QVector2D m_resolution;
     unsigned int m_texture = 0;
-    unsigned int m_sourceTexture = 0;
-    unsigned int m_tile1 = 0;
-    unsigned int m_tile2 = 0;
-    unsigned int m_tile3 = 0;
-    unsigned int m_tile4 = 0;
-    unsigned int m_tile5 = 0;
+    QVector<unsigned int> m_tiles;
     unsigned int m_maskTexture = 0;
     float m_offsetX = 0.0f;
     float m_offsetY = 0.0f;
@@ -115,35 +106,42 @@ private:
     int m_seed = 1;
     bool m_keepProportion = false;
     bool m_useAlpha = true;
+    bool m_scatter = false;
 };
 
-class TileRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class TileRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     TileRenderer(QVector2D res);
     ~TileRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void createTile();
-    void createRandom();
+    void createScatter();
+    void updateInstances(TileObject *item);
+    void updateTilesArray();
+    bool hasTiles();
     void updateTexResolution();
     void saveTexture(QString fileName);
     QVector2D m_resolution;
-    unsigned int m_sourceTexture = 0;
-    unsigned int m_tile1 = 0;
-    unsigned int m_tile2 = 0;
-    unsigned int m_tile3 = 0;
-    unsigned int m_tile4 = 0;
-    unsigned int m_tile5 = 0;
+    QVector<unsigned int> m_tiles;
+    QVector<int> m_tileLayers;
     unsigned int m_tiledTexture = 0;
-    unsigned int m_randomTexture = 0;
+    unsigned int tilesArray = 0;
     unsigned int maskTexture = 0;
     unsigned int textureVAO = 0;
+    unsigned int scatterVAO = 0;
+    unsigned int cornersVBO = 0;
+    unsigned int instanceVBO = 0;
     unsigned int tileFBO = 0;
-    unsigned int randomFBO = 0;
+    unsigned int copyFBO = 0;
+    int tilesLayers = 0;
+    QSet<int> dirtyLayers;
+    int instanceCount = 0;
+    bool m_useAlpha = true;
     QOpenGLShaderProgram *tileShader;
-    QOpenGLShaderProgram *randomShader;
+    QOpenGLShaderProgram *scatterShader;
+    QOpenGLShaderProgram *maskShader;
     QOpenGLShaderProgram *checkerShader;
     QOpenGLShaderProgram *textureShader;
 };
@@ -61,9 +61,22 @@ TileNode::TileNode(QQuickItem *parent, QVector2D resolution, float offsetX, floa
     connect(this, &TileNode::seedChanged, preview, &TileObject::setSeed);
     connect(this, &TileNode::keepProportionChanged, preview, &TileObject::setKeepProportion);
     connect(this, &TileNode::useAlphaChanged, preview, &TileObject::setUseAlpha);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/TileProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
+    connect(this, &TileNode::scatterChanged, preview, &TileObject::setScatter);
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/TileProperty.qml"));
+    createSockets(2, 1);
+    createTileInputs(m_inputsCount - 1);
+    connect(m_socketsInput[0], &Socket::valueChanged, this, [this]() { m_changedTiles.insert(0); });
+    setTitle("Tile");
+    m_socketsInput[0]->setTip("Texture");
+    m_socketsInput[1]->setTip("Mask");
+}
+
+TileNode::~TileNode() {
+    delete preview;
+}
+
+void TileNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startScatter", m_scatter);
     propertiesPanel->setProperty("startOffsetX", m_offsetX);
     propertiesPanel->setProperty("startOffsetY", m_offsetY);
     propertiesPanel->setProperty("startColumns", m_columns);
@@ -94,41 +107,19 @@ TileNode::TileNode(QQuickItem *parent, QVector2D resolution, float offsetX, floa
     connect(propertiesPanel, SIGNAL(seedChanged(int)), this, SLOT(updateSeed(int)));
     connect(propertiesPanel, SIGNAL(keepProportionChanged(bool)), this, SLOT(updateKeepProportion(bool)));
     connect(propertiesPanel, SIGNAL(useAlphaChanged(bool)), this, SLOT(updateUseAlpha(bool)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-    createSockets(2, 1);
-    createAdditionalInputs(5);
-    for(int i = 0; i < 5; ++i) {
-        Socket *s = m_additionalInputs[i];
-        if(i < m_inputsCount - 1) {
-            s->setVisible(true);
-        }
-        else {
-            s->setVisible(false);
-        }
-    }
-    setTitle("Tile");
-    m_socketsInput[0]->setTip("Texture");
-    m_socketsInput[1]->setTip("Mask");
-    m_additionalInputs[0]->setTip("Texture");
-    m_additionalInputs[1]->setTip("Texture");
-    m_additionalInputs[2]->setTip("Texture");
-    m_additionalInputs[3]->setTip("Texture");
-    m_additionalInputs[4]->setTip("Texture");
-}
-
-TileNode::~TileNode() {
-    delete preview;
+    connect(propertiesPanel, SIGNAL(scatterChanged(bool)), this, SLOT(updateScatter(bool)));
 }
 
 void TileNode::operation() {
     preview->selectedItem = selected();
-    preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
+    QVector<unsigned int> tiles;
+    tiles.append(m_socketsInput[0]->value().toUInt());
+    for(int i = 0; i < m_inputsCount - 1; ++i) {
+        tiles.append(m_additionalInputs[i]->value().toUInt());
+    }
     preview->setMaskTexture(m_socketsInput[1]->value().toUInt());
-    preview->setTile1(m_additionalInputs[0]->value().toUInt());
-    preview->setTile2(m_additionalInputs[1]->value().toUInt());
-    preview->setTile3(m_additionalInputs[2]->value().toUInt());
-    preview->setTile4(m_additionalInputs[3]->value().toUInt());
-    preview->setTile5(m_additionalInputs[4]->value().toUInt());
+    preview->setTiles(tiles, m_changedTiles);
+    m_changedTiles.clear();
 }
 
 unsigned int &TileNode::getPreviewTexture() {
@@ -139,6 +130,10 @@ void TileNode::saveTexture(QString fileName) {
     preview->saveTexture(fileName);
 }
 
+bool TileNode::costlyOperation() const {
+    return true;
+}
+
 void TileNode::serialize(QJsonObject &json) const {
     Node::serialize(json);
     json["type"] = 17;
@@ -157,79 +152,62 @@ void TileNode::serialize(QJsonObject &json) const {
     json["seed"] = m_seed;
     json["keepProportion"] = m_keepProportion;
     json["useAlpha"] = m_useAlpha;
+    json["scatter"] = m_scatter;
 }
 
 void TileNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
+    if(json.contains("additionals")) {
+        createTileInputs(qMin(json["additionals"].toArray().size(), maxTileInputs - 1));
+    }
     Node::deserialize(json, hash);
     if(json.contains("offsetX")) {
-        m_offsetX = json["offsetX"].toVariant().toFloat();
+        setOffsetX(json["offsetX"].toVariant().toFloat());
     }
     if(json.contains("offsetY")) {
-        m_offsetY = json["offsetY"].toVariant().toFloat();
+        setOffsetY(json["offsetY"].toVariant().toFloat());
     }
     if(json.contains("columns")) {
-        m_columns = json["columns"].toVariant().toInt();
+        setColumns(json["columns"].toVariant().toInt());
     }
     if(json.contains("rows")) {
-        m_rows = json["rows"].toVariant().toInt();
+        setRows(json["rows"].toVariant().toInt());
     }
     if(json.contains("scaleX")) {
-        m_scaleX = json["scaleX"].toVariant().toFloat();
+        setScaleX(json["scaleX"].toVariant().toFloat());
     }
     if(json.contains("scaleY")) {
-        m_scaleY = json["scaleY"].toVariant().toFloat();
+        setScaleY(json["scaleY"].toVariant().toFloat());
     }
     if(json.contains("rotation")) {
-        m_rotationAngle = json["rotation"].toVariant().toFloat();
+        setRotationAngle(json["rotation"].toVariant().toFloat());
     }
     if(json.contains("randPosition")) {
-        m_randPosition = json["randPosition"].toVariant().toFloat();
+        setRandPosition(json["randPosition"].toVariant().toFloat());
     }
     if(json.contains("randRotation")) {
-        m_randRotation = json["randRotation"].toVariant().toFloat();
+        setRandRotation(json["randRotation"].toVariant().toFloat());
     }
     if(json.contains("randScale")) {
-        m_randScale = json["randScale"].toVariant().toFloat();
+        setRandScale(json["randScale"].toVariant().toFloat());
     }
     if(json.contains("maskStrength")) {
-        m_maskStrength = json["maskStrength"].toVariant().toFloat();
+        setMaskStrength(json["maskStrength"].toVariant().toFloat());
     }
     if(json.contains("inputsCount")) {
-        m_inputsCount = json["inputsCount"].toInt();
+        setInputsCount(json["inputsCount"].toInt());
     }
     if(json.contains("seed")) {
-        m_seed = json["seed"].toInt();
+        setSeed(json["seed"].toInt());
     }
     if(json.contains("keepProportion")) {
-        m_keepProportion = json["keepProportion"].toBool();
+        setKeepProportion(json["keepProportion"].toBool());
     }
     if(json.contains("useAlpha")) {
-        m_useAlpha = json["useAlpha"].toBool();
+        setUseAlpha(json["useAlpha"].toBool());
     }
-    for(int i = 0; i < 5; ++i) {
-        Socket *s = m_additionalInputs[i];
-        if(i < m_inputsCount - 1) {
-            s->setVisible(true);
-        }
-        else {
-            s->setVisible(false);
-        }
+    if(json.contains("scatter")) {
+        setScatter(json["scatter"].toBool());
     }
-    propertiesPanel->setProperty("startOffsetX", m_offsetX);
-    propertiesPanel->setProperty("startOffsetY", m_offsetY);
-    propertiesPanel->setProperty("startColumns", m_columns);
-    propertiesPanel->setProperty("startRows", m_rows);
-    propertiesPanel->setProperty("startScaleX", m_scaleX);
-    propertiesPanel->setProperty("startScaleY", m_scaleY);
-    propertiesPanel->setProperty("startRotation", m_rotationAngle);
-    propertiesPanel->setProperty("startRandPosition", m_randPosition);
-    propertiesPanel->setProperty("startRandRotation", m_randRotation);
-    propertiesPanel->setProperty("startRandScale", m_randScale);
-    propertiesPanel->setProperty("startMask", m_maskStrength);
-    propertiesPanel->setProperty("startInputsCount", m_inputsCount);
-    propertiesPanel->setProperty("startSeed", m_seed);
-    propertiesPanel->setProperty("startKeepProportion", m_keepProportion);
-    propertiesPanel->setProperty("startUseAlpha", m_useAlpha);
 }
 
 float TileNode::offsetX() {
@@ -337,7 +315,8 @@ int TileNode::inputsCount() {
 
 void TileNode::setInputsCount(int count) {
     m_inputsCount = count;
-    for(int i = 0; i < 5; ++i) {
+    createTileInputs(count - 1);
+    for(int i = 0; i < m_additionalInputs.size(); ++i) {
         Socket *s = m_additionalInputs[i];
         if(i < count - 1) {
             s->setVisible(true);
@@ -383,6 +362,15 @@ void TileNode::setUseAlpha(bool use) {
     useAlphaChanged(use);
 }
 
+bool TileNode::scatter() {
+    return m_scatter;
+}
+
+void TileNode::setScatter(bool scatter) {
+    m_scatter = scatter;
+    scatterChanged(scatter);
+}
+
 void TileNode::setOutput() {
     m_socketOutput[0]->setValue(preview->texture());
 }
@@ -396,97 +384,113 @@ void TileNode::updateScale(float scale) {
 
 void TileNode::previewGenerated() {
     preview->tiledTex = true;
-    preview->randUpdated = true;
     preview->update();
 }
 
 void TileNode::updateOffsetX(qreal offset) {
     setOffsetX(offset);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateOffsetY(qreal offset) {
     setOffsetY(offset);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateColums(int columns) {
     setColumns(columns);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateRows(int rows) {
     setRows(rows);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateScaleX(qreal scale) {
     setScaleX(scale);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateScaleY(qreal scale) {
     setScaleY(scale);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateRotationAngle(int angle) {
     setRotationAngle(angle);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateRandPosition(qreal rand) {
     setRandPosition(rand);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateRandRotation(qreal rand) {
     setRandRotation(rand);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateRandScale(qreal rand) {
     setRandScale(rand);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateMaskStrength(qreal mask) {
     setMaskStrength(mask);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateInputsCount(int count) {
     setInputsCount(count);
     if(attachedFrame()) attachedFrame()->resizeByContent();
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateSeed(int seed) {
     setSeed(seed);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateKeepProportion(bool keep) {
     setKeepProportion(keep);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TileNode::updateUseAlpha(bool use) {
     setUseAlpha(use);
-    operation();
+    requestOperation();
     dataChanged();
 }
+
+void TileNode::updateScatter(bool scatter) {
+    setScatter(scatter);
+    requestOperation();
+    dataChanged();
+}
+
+void TileNode::createTileInputs(int count) {
+    int created = m_additionalInputs.size();
+    createAdditionalInputs(count);
+    for(int i = created; i < m_additionalInputs.size(); ++i) {
+        Socket *s = m_additionalInputs[i];
+        s->setTip("Texture");
+        s->setVisible(i < m_inputsCount - 1);
+        connect(s, &Socket::valueChanged, this, [this, i]() { m_changedTiles.insert(i + 1); });
+    }
+}
@@ -24,6 +24,7 @@
 
 #include "node.h"
 #include "tile.h"
+#include <QSet>
 
 class TileNode: public Node
 {
@@ -34,6 +35,7 @@ public:
     void operation();
     unsigned int &getPreviewTexture();
     void saveTexture(QString fileName);
+    bool costlyOperation() const;
     void serialize(QJsonObject &json) const;
     void deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash);
     float offsetX();
@@ -66,6 +68,8 @@ public:
     void setKeepProportion(bool keep);
     bool useAlpha();
     void setUseAlpha(bool use);
+    bool scatter();
+    void setScatter(bool scatter);
     void setOutput();
 signals:
     void offsetXChanged(float offset);
@@ -83,6 +87,7 @@ signals:
     void seedChanged(int seed);
     void keepProportionChanged(bool keep);
     void useAlphaChanged(bool use);
+    void scatterChanged(bool scatter);
 public slots:
     void updateScale(float scale);
     void previewGenerated();
@@ -101,8 +106,13 @@ public slots:
     void updateSeed(int seed);
     void updateKeepProportion(bool keep);
     void updateUseAlpha(bool use);
+    void updateScatter(bool scatter);
+protected:
+    void setupPropertyPanel();
 private:
+    void createTileInputs(int count);
     TileObject *preview;
+    QSet<int> m_changedTiles;
     float m_offsetX = 0.0f;
     float m_offsetY = 0.0f;
     int m_columns = 5;
@@ -118,6 +128,7 @@ private:
     int m_seed = 1;
     bool m_keepProportion = false;
     bool m_useAlpha = true;
+    bool m_scatter = false;
 };
 
 #endif // TILENODE_H
@@ -20,12 +20,12 @@
  */
 
 #include "transform.h"
-#include "QOpenGLFramebufferObjectFormat"
+#include "shaderwarmup.h"
 #include "FreeImage.h"
 
 TransformObject::TransformObject(QQuickItem *parent, QVector2D resolution, float transX, float transY,
                                  float scaleX, float scaleY, int angle, bool clamp):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_translateX(transX), m_translateY(transY),
+    ThumbnailObject(parent), m_resolution(resolution), m_translateX(transX), m_translateY(transY),
     m_scaleX(scaleX), m_scaleY(scaleY), m_angle(angle), m_clamp(clamp)
 {
 
@@ -130,6 +130,16 @@ void TransformObject::setClampCoords(bool clamp) {
     update();
 }
 
+QVector<UVStage> TransformObject::uvStages() {
+    return m_uvStages;
+}
+
+void TransformObject::setUVStages(QVector<UVStage> stages) {
+    m_uvStages = stages;
+    transformedTex = true;
+    update();
+}
+
 QVector2D TransformObject::resolution() {
     return m_resolution;
 }
@@ -142,18 +152,9 @@ void TransformObject::setResolution(QVector2D res) {
 
 TransformRenderer::TransformRenderer(QVector2D resolution): m_resolution(resolution) {
     initializeOpenGLFunctions();
-    transformShader = new QOpenGLShaderProgram();
-    transformShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    transformShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/transform.frag");
-    transformShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    transformShader = createShaderProgram(PROGRAM_TRANSFORM);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     transformShader->bind();
     transformShader->setUniformValue(transformShader->uniformLocation("transTexture"), 0);
     transformShader->setUniformValue(transformShader->uniformLocation("maskTexture"), 1);
@@ -197,14 +198,8 @@ TransformRenderer::~TransformRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *TransformRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void TransformRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     TransformObject *transformItem = static_cast<TransformObject*>(item);
     if(transformItem->resUpdated) {
         transformItem->resUpdated;
@@ -223,6 +218,7 @@ void TransformRenderer::synchronize(QQuickFramebufferObject *item) {
             transformShader->setUniformValue(transformShader->uniformLocation("angle"), transformItem->rotation());
             transformShader->setUniformValue(transformShader->uniformLocation("clampTrans"), transformItem->clampCoords());
             transformShader->setUniformValue(transformShader->uniformLocation("useMask"), maskTexture);
+            setUVStagesUniforms(transformShader, transformItem->uvStages());
             transformShader->release();
             transformateTexture();
             transformItem->setTexture(m_transformedTexture);
@@ -235,7 +231,7 @@ void TransformRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void TransformRenderer::render() {
+void TransformRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
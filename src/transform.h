@@ -22,11 +22,12 @@
 #ifndef TRANSFORM_H
 #define TRANSFORM_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
+#include "uvchain.h"
 
-class TransformObject: public QQuickFramebufferObject
+class TransformObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -51,6 +52,8 @@ public:
     void setRotation(int angle);
     bool clampCoords();
     void setClampCoords(bool clamp);
+    QVector<UVStage> uvStages();
+    void setUVStages(QVector<UVStage> stages);
     QVector2D resolution();
     void setResolution(QVector2D res);
     bool transformedTex = false;
@@ -72,15 +75,15 @@ private:
     bool m_clamp = false;
     unsigned int m_texture = 0;
     unsigned int m_maskTexture = 0;
+    QVector<UVStage> m_uvStages;
 };
 
-class TransformRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class TransformRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     TransformRenderer(QVector2D resolution);
     ~TransformRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void transformateTexture();
     void updateTexResolution();
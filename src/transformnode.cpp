@@ -44,9 +44,18 @@ TransformNode::TransformNode(QQuickItem *parent, QVector2D resolution, float tra
     connect(this, &TransformNode::scaleYChanged, preview, &TransformObject::setScaleY);
     connect(this, &TransformNode::rotationChanged, preview, &TransformObject::setRotation);
     connect(this, &TransformNode::clampCoordsChanged, preview, &TransformObject::setClampCoords);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/TransformProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/TransformProperty.qml"));
+    createSockets(2, 1);
+    setTitle("Transform");
+    m_socketsInput[0]->setTip("Texture");
+    m_socketsInput[1]->setTip("Mask");
+}
+
+TransformNode::~TransformNode() {
+    delete preview;
+}
+
+void TransformNode::setupPropertyPanel() {
     propertiesPanel->setProperty("startTransX", m_transX);
     propertiesPanel->setProperty("startTransY", m_transY);
     propertiesPanel->setProperty("startScaleX", m_scaleX);
@@ -59,20 +68,14 @@ TransformNode::TransformNode(QQuickItem *parent, QVector2D resolution, float tra
     connect(propertiesPanel, SIGNAL(scaleYChanged(qreal)), this, SLOT(updateScaleY(qreal)));
     connect(propertiesPanel, SIGNAL(angleChanged(int)), this, SLOT(updateRotation(int)));
     connect(propertiesPanel, SIGNAL(clampCoordsChanged(bool)), this, SLOT(updateClampCoords(bool)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-    createSockets(2, 1);
-    setTitle("Transform");
-    m_socketsInput[0]->setTip("Texture");
-    m_socketsInput[1]->setTip("Mask");
-}
-
-TransformNode::~TransformNode() {
-    delete preview;
 }
 
 void TransformNode::operation() {
     preview->selectedItem = selected();
-    preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
+    QVector<UVStage> stages;
+    unsigned int source = collectUVChain(m_socketsInput[0], stages);
+    preview->setUVStages(stages);
+    preview->setSourceTexture(source);
     preview->setMaskTexture(m_socketsInput[1]->value().toUInt());
     if(m_socketsInput[0]->countEdge() == 0) m_socketOutput[0]->setValue(0);
 }
@@ -85,6 +88,14 @@ void TransformNode::saveTexture(QString fileName) {
     preview->saveTexture(fileName);
 }
 
+bool TransformNode::uvStage(UVStage &stage, Socket *&source) {
+    if(m_socketsInput[1]->countEdge() > 0) return false;
+    stage.matrix = affineUV(m_transX, m_transY, m_scaleX, m_scaleY, m_angle);
+    stage.mode = m_clamp ? UV_AFFINE_CLAMP : UV_AFFINE;
+    source = m_socketsInput[0];
+    return true;
+}
+
 void TransformNode::serialize(QJsonObject &json) const {
     Node::serialize(json);
     json["type"] = 16;
@@ -99,29 +110,23 @@ void TransformNode::serialize(QJsonObject &json) const {
 void TransformNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
     Node::deserialize(json, hash);
     if(json.contains("transX")) {
-        m_transX = json["transX"].toVariant().toFloat();
+        setTranslationX(json["transX"].toVariant().toFloat());
     }
     if(json.contains("transY")) {
-        m_transY = json["transY"].toVariant().toFloat();
+        setTranslationY(json["transY"].toVariant().toFloat());
     }
     if(json.contains("scaleX")) {
-        m_scaleX = json["scaleX"].toVariant().toFloat();
+        setScaleX(json["scaleX"].toVariant().toFloat());
     }
     if(json.contains("scaleY")) {
-        m_scaleY = json["scaleY"].toVariant().toFloat();
+        setScaleY(json["scaleY"].toVariant().toFloat());
     }
     if(json.contains("angle")) {
-        m_angle = json["angle"].toVariant().toInt();
+        setRotation(json["angle"].toVariant().toInt());
     }
     if(json.contains("clamp")) {
-        m_clamp = json["clamp"].toVariant().toBool();
+        setClampCoords(json["clamp"].toVariant().toBool());
     }
-    propertiesPanel->setProperty("startTransX", m_transX);
-    propertiesPanel->setProperty("startTransY", m_transY);
-    propertiesPanel->setProperty("startScaleX", m_scaleX);
-    propertiesPanel->setProperty("startScaleY", m_scaleY);
-    propertiesPanel->setProperty("startRotation", m_angle);
-    propertiesPanel->setProperty("startClamp", m_clamp);
 }
 
 float TransformNode::translationX() {
@@ -195,36 +200,36 @@ void TransformNode::previewGenerated() {
 
 void TransformNode::updateTranslationX(qreal x) {
     setTranslationX(x);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TransformNode::updateTranslationY(qreal y) {
     setTranslationY(y);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TransformNode::updateScaleX(qreal x) {
     setScaleX(x);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TransformNode::updateScaleY(qreal y) {
     setScaleY(y);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TransformNode::updateRotation(int angle) {
     setRotation(angle);
-    operation();
+    requestOperation();
     dataChanged();
 }
 
 void TransformNode::updateClampCoords(bool clamp) {
     setClampCoords(clamp);
-    operation();
+    requestOperation();
     dataChanged();
 }
@@ -36,6 +36,7 @@ public:
     void saveTexture(QString fileName);
     void serialize(QJsonObject &json) const;
     void deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash);
+    bool uvStage(UVStage &stage, Socket *&source);
     float translationX();
     void setTranslationX(float x);
     float translationY();
@@ -65,6 +66,8 @@ public slots:
     void updateScaleY(qreal y);
     void updateRotation(int angle);
     void updateClampCoords(bool clamp);
+protected:
+    void setupPropertyPanel();
 private:
     TransformObject *preview;
     float m_transX = 0.0f;
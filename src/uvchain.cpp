@@ -0,0 +1,71 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "uvchain.h"
+#include "node.h"
+#include <QtMath>
+#include <QOpenGLShaderProgram>
+
+QMatrix3x3 affineUV(float transX, float transY, float scaleX, float scaleY, int angle) {
+    float c = qCos(qDegreesToRadians(static_cast<float>(angle)));
+    float s = qSin(qDegreesToRadians(static_cast<float>(angle)));
+    float tx = transX - 0.5f;
+    float ty = transY - 0.5f;
+    float values[] = {c/scaleX, -s/scaleX, (c*tx - s*ty)/scaleX + 0.5f,
+                      s/scaleY, c/scaleY, (s*tx + c*ty)/scaleY + 0.5f,
+                      0.0f, 0.0f, 1.0f};
+    return QMatrix3x3(values);
+}
+
+unsigned int collectUVChain(Socket *input, QVector<UVStage> &stages) {
+    stages.clear();
+    Socket *socket = input;
+    unsigned int texture = socket->value().toUInt();
+    while(stages.size() < maxUVStages && socket->countEdge() > 0) {
+        Socket *startSocket = socket->getEdges()[0]->startSocket();
+        if(!startSocket) break;
+        Node *node = qobject_cast<Node*>(startSocket->parentItem());
+        UVStage stage;
+        Socket *source = nullptr;
+        if(!node || !node->uvStage(stage, source) || source->countEdge() == 0) break;
+        stages.append(stage);
+        socket = source;
+        texture = socket->value().toUInt();
+    }
+    return texture;
+}
+
+void setUVStagesUniforms(QOpenGLShaderProgram *shader, const QVector<UVStage> &stages) {
+    // matches the stage uniforms declared in uvchain.glsl
+    QMatrix3x3 matrices[maxUVStages];
+    int modes[maxUVStages];
+    int dirs[maxUVStages];
+    for(int i = 0; i < stages.size(); ++i) {
+        matrices[i] = stages[i].matrix;
+        modes[i] = stages[i].mode;
+        dirs[i] = stages[i].dir;
+    }
+    shader->setUniformValue(shader->uniformLocation("stageCount"), stages.size());
+    if(stages.isEmpty()) return;
+    shader->setUniformValueArray(shader->uniformLocation("stageMatrix"), matrices, stages.size());
+    shader->setUniformValueArray(shader->uniformLocation("stageMode"), modes, stages.size());
+    shader->setUniformValueArray(shader->uniformLocation("stageDir"), dirs, stages.size());
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright © 2020 Gukova Anastasiia
+ * Copyright © 2020 Gukov Anton <fexcron@gmail.com>
+ *
+ *
+ * This file is part of Symbinode.
+ *
+ * Symbinode is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Symbinode is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Symbinode.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef UVCHAIN_H
+#define UVCHAIN_H
+#include <QGenericMatrix>
+#include <QVector>
+
+class Socket;
+class QOpenGLShaderProgram;
+
+enum uvStageMode {UV_AFFINE, UV_AFFINE_CLAMP, UV_MIRROR};
+
+struct UVStage {
+    QMatrix3x3 matrix;
+    int mode = UV_AFFINE;
+    int dir = 0;
+};
+
+const int maxUVStages = 8;
+
+QMatrix3x3 affineUV(float transX, float transY, float scaleX, float scaleY, int angle);
+unsigned int collectUVChain(Socket *input, QVector<UVStage> &stages);
+void setUVStagesUniforms(QOpenGLShaderProgram *shader, const QVector<UVStage> &stages);
+
+#endif // UVCHAIN_H
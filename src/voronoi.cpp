@@ -21,12 +21,14 @@
 
 #include <iostream>
 #include "voronoi.h"
-#include <QOpenGLFramebufferObjectFormat>
+#include "shaderwarmup.h"
 #include "FreeImage.h"
+#include "hash.h"
+#include <QVector>
 
 VoronoiObject::VoronoiObject(QQuickItem *parent, QVector2D resolution, QString voronoiType, int scale,
                              int scaleX, int scaleY, float jitter, bool inverse, float intensity,
-                             float bordersSize, int seed): QQuickFramebufferObject(parent),
+                             float bordersSize, int seed): ThumbnailObject(parent),
     m_resolution(resolution), m_voronoiType(voronoiType), m_scale(scale), m_scaleX(scaleX),
     m_scaleY(scaleY), m_jitter(jitter), m_inverse(inverse), m_intensity(intensity),
     m_borders(bordersSize), m_seed(seed)
@@ -165,20 +167,12 @@ void VoronoiObject::setResolution(QVector2D res) {
 
 VoronoiRenderer::VoronoiRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    generateVoronoi = new QOpenGLShaderProgram();
-    generateVoronoi->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/noise.vert");
-    generateVoronoi->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/voronoi.frag");
-    generateVoronoi->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    renderTexture = new QOpenGLShaderProgram();
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    renderTexture->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    renderTexture->link();
+    generateVoronoi = createShaderProgram(PROGRAM_VORONOI);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    renderTexture = createShaderProgram(PROGRAM_TEXTURE);
     generateVoronoi->bind();
     generateVoronoi->setUniformValue(generateVoronoi->uniformLocation("maskTexture"), 0);
+    generateVoronoi->setUniformValue(generateVoronoi->uniformLocation("featurePoints"), 1);
     generateVoronoi->release();
     renderTexture->bind();
     renderTexture->setUniformValue(renderTexture->uniformLocation("texture"), 0);
@@ -227,23 +221,26 @@ VoronoiRenderer::VoronoiRenderer(QVector2D res): m_resolution(res) {
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, voronoiTexture, 0);    
     glBindTexture(GL_TEXTURE_2D, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    glGenTextures(1, &pointsTexture);
+    glBindTexture(GL_TEXTURE_2D, pointsTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    // the shader wraps cells by the size of the points texture, it must never be empty
+    updateFeaturePoints(1, 1, 1, 1);
     createVoronoi();
 }
 
 VoronoiRenderer::~VoronoiRenderer() {
+    glDeleteTextures(1, &pointsTexture);
     delete generateVoronoi;
     delete  checkerShader;
     delete renderTexture;
 }
 
-QOpenGLFramebufferObject *VoronoiRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void VoronoiRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     VoronoiObject *voronoiItem = static_cast<VoronoiObject*>(item);
     if(voronoiItem->resUpdated) {
         voronoiItem->resUpdated = false;
@@ -258,6 +255,7 @@ void VoronoiRenderer::synchronize(QQuickFramebufferObject *item) {
         voronoiItem->generatedVoronoi = false;
         m_voronoiType = voronoiItem->voronoiType();
         maskTexture = voronoiItem->maskTexture();
+        updateFeaturePoints(voronoiItem->voronoiScale(), voronoiItem->scaleX(), voronoiItem->scaleY(), voronoiItem->seed());
         generateVoronoi->bind();
         generateVoronoi->setUniformValue(generateVoronoi->uniformLocation("scale"), voronoiItem->voronoiScale());
         generateVoronoi->setUniformValue(generateVoronoi->uniformLocation("scaleX"), voronoiItem->scaleX());
@@ -279,7 +277,7 @@ void VoronoiRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void VoronoiRenderer::render() {
+void VoronoiRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -315,13 +313,37 @@ void VoronoiRenderer::createVoronoi() {
     generateVoronoi->setUniformValue(generateVoronoi->uniformLocation("res"), m_resolution);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, maskTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, pointsTexture);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
     generateVoronoi->release();
     glBindVertexArray(0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void VoronoiRenderer::updateFeaturePoints(int scale, int scaleX, int scaleY, int seed) {
+    int width = qMax(1, scale*scaleX);
+    int height = qMax(1, scale*scaleY);
+    if(width == m_pointsWidth && height == m_pointsHeight && seed == m_pointsSeed) return;
+    m_pointsWidth = width;
+    m_pointsHeight = height;
+    m_pointsSeed = seed;
+    QVector<float> points(2*width*height);
+    for(int y = 0; y < height; ++y) {
+        for(int x = 0; x < width; ++x) {
+            QVector2D point = hash22(x, y, seed);
+            points[2*(y*width + x)] = point.x();
+            points[2*(y*width + x) + 1] = point.y();
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, pointsTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F, width, height, 0, GL_RG, GL_FLOAT, points.constData());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void VoronoiRenderer::updateTexResolution() {
     glBindTexture(GL_TEXTURE_2D, voronoiTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_resolution.x(), m_resolution.y(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
@@ -22,11 +22,11 @@
 #ifndef VORONOI_H
 #define VORONOI_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 
-class VoronoiObject: public QQuickFramebufferObject
+class VoronoiObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -80,16 +80,16 @@ private:
     int m_seed = 1;
 };
 
-class VoronoiRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core
+class VoronoiRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core
 {
 public:
     VoronoiRenderer(QVector2D resolution);
     ~VoronoiRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void createVoronoi();
+    void updateFeaturePoints(int scale, int scaleX, int scaleY, int seed);
     void updateTexResolution();
     void saveTexture(QString fileName);
     QOpenGLShaderProgram *generateVoronoi;
@@ -99,6 +99,10 @@ private:
     unsigned int voronoiVAO, textureVAO;
     unsigned int voronoiTexture;
     unsigned int maskTexture = 0;
+    unsigned int pointsTexture = 0;
+    int m_pointsWidth = 0;
+    int m_pointsHeight = 0;
+    int m_pointsSeed = 0;
     QVector2D m_resolution;
     QString m_voronoiType;
 };
@@ -51,9 +51,14 @@ VoronoiNode::VoronoiNode(QQuickItem *parent, QVector2D resolution, VoronoiParams
     createSockets(1, 1);
     m_socketsInput[0]->setTip("Mask");
     setTitle("Voronoi");
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/VoronoiProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/VoronoiProperty.qml"));
+}
+
+VoronoiNode::~VoronoiNode() {
+    delete preview;
+}
+
+void VoronoiNode::setupPropertyPanel() {
     int index = 0;
     if(m_voronoiType == "borders") index = 1;
     else if(m_voronoiType == "solid") index = 2;
@@ -76,11 +81,6 @@ VoronoiNode::VoronoiNode(QQuickItem *parent, QVector2D resolution, VoronoiParams
     connect(propertiesPanel, SIGNAL(intensityChanged(qreal)), this, SLOT(updateIntensity(qreal)));
     connect(propertiesPanel, SIGNAL(bordersChanged(qreal)), this, SLOT(updateBordersSize(qreal)));
     connect(propertiesPanel, SIGNAL(seedChanged(int)), this, SLOT(updateSeed(int)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
-}
-
-VoronoiNode::~VoronoiNode() {
-    delete preview;
 }
 
 void VoronoiNode::operation() {
@@ -96,6 +96,10 @@ void VoronoiNode::saveTexture(QString fileName) {
     preview->saveTexture(fileName);
 }
 
+bool VoronoiNode::costlyOperation() const {
+    return true;
+}
+
 void VoronoiNode::serialize(QJsonObject &json) const {
     Node::serialize(json);
     json["type"] = 13;
@@ -242,21 +246,8 @@ void VoronoiNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &h
     }
     if(json.contains("voronoiType")) {
         m_voronoiType = json["voronoiType"].toVariant().toString();
-        voronoiTypeChanged(m_voronoiType);
-        int index = 0;
-        if(m_voronoiType == "borders") index = 1;
-        else if(m_voronoiType == "solid") index = 2;
-        else if(m_voronoiType == "worley") index = 3;
-        propertiesPanel->setProperty("type", index);
-        propertiesPanel->setProperty("startScale", voronoiScale());
-        propertiesPanel->setProperty("startScaleX", scaleX());
-        propertiesPanel->setProperty("startScaleY", scaleY());
-        propertiesPanel->setProperty("startJitter", jitter());
-        propertiesPanel->setProperty("startInverse", inverse());
-        propertiesPanel->setProperty("startIntensity", intensity());
-        propertiesPanel->setProperty("startBorders", bordersSize());
-        propertiesPanel->setProperty("startSeed", seed());
     }
+    setVoronoiType(m_voronoiType);
 }
 
 VoronoiParams VoronoiNode::crystalsParam() {
@@ -282,14 +273,24 @@ QString VoronoiNode::voronoiType() {
 void VoronoiNode::setVoronoiType(QString type) {
     m_voronoiType = type;
     voronoiTypeChanged(type);
-    propertiesPanel->setProperty("startScale", voronoiScale());
-    propertiesPanel->setProperty("startScaleX", scaleX());
-    propertiesPanel->setProperty("startScaleY", scaleY());
-    propertiesPanel->setProperty("startJitter", jitter());
-    propertiesPanel->setProperty("startIntensity", intensity());
-    propertiesPanel->setProperty("startInverse", inverse());
-    propertiesPanel->setProperty("startBorders", bordersSize());
-    propertiesPanel->setProperty("startSeed", seed());
+    voronoiScaleChanged(voronoiScale());
+    scaleXChanged(scaleX());
+    scaleYChanged(scaleY());
+    jitterChanged(jitter());
+    intensityChanged(intensity());
+    inverseChanged(inverse());
+    bordersSizeChanged(bordersSize());
+    seedChanged(seed());
+    if(propertiesPanel) {
+        propertiesPanel->setProperty("startScale", voronoiScale());
+        propertiesPanel->setProperty("startScaleX", scaleX());
+        propertiesPanel->setProperty("startScaleY", scaleY());
+        propertiesPanel->setProperty("startJitter", jitter());
+        propertiesPanel->setProperty("startIntensity", intensity());
+        propertiesPanel->setProperty("startInverse", inverse());
+        propertiesPanel->setProperty("startBorders", bordersSize());
+        propertiesPanel->setProperty("startSeed", seed());
+    }
 }
 
 int VoronoiNode::voronoiScale() {
@@ -48,6 +48,7 @@ public:
     void operation();
     unsigned int &getPreviewTexture();
     void saveTexture(QString fileName);
+    bool costlyOperation() const;
     void serialize(QJsonObject &json) const;
     void deserialize(const QJsonObject &json, QHash<QUuid, Socket*> &hash);
     VoronoiParams crystalsParam();
@@ -95,6 +96,8 @@ public slots:
     void updateIntensity(qreal intensity);
     void updateBordersSize(qreal size);
     void updateSeed(int seed);
+protected:
+    void setupPropertyPanel();
 private:
     VoronoiObject *preview;
     QString m_voronoiType = "crystals";
@@ -20,12 +20,12 @@
  */
 
 #include "warp.h"
+#include "shaderwarmup.h"
 #include <iostream>
-#include <QOpenGLFramebufferObjectFormat>
 #include "FreeImage.h"
 
 WarpObject::WarpObject(QQuickItem *parent, QVector2D resolution, float intensity):
-    QQuickFramebufferObject (parent), m_resolution(resolution), m_intensity(intensity)
+    ThumbnailObject(parent), m_resolution(resolution), m_intensity(intensity)
 {
 
 }
@@ -101,18 +101,9 @@ void WarpObject::setResolution(QVector2D res) {
 
 WarpRenderer::WarpRenderer(QVector2D res): m_resolution(res) {
     initializeOpenGLFunctions();
-    warpShader = new QOpenGLShaderProgram();
-    warpShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    warpShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/warp.frag");
-    warpShader->link();
-    checkerShader = new QOpenGLShaderProgram();
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/checker.vert");
-    checkerShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/checker.frag");
-    checkerShader->link();
-    textureShader = new QOpenGLShaderProgram();
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/texture.vert");
-    textureShader->addCacheableShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/texture.frag");
-    textureShader->link();
+    warpShader = createShaderProgram(PROGRAM_WARP);
+    checkerShader = createShaderProgram(PROGRAM_CHECKER);
+    textureShader = createShaderProgram(PROGRAM_TEXTURE);
     warpShader->bind();
     warpShader->setUniformValue(warpShader->uniformLocation("sourceTexture"), 0);
     warpShader->setUniformValue(warpShader->uniformLocation("warpTexture"), 1);
@@ -157,14 +148,8 @@ WarpRenderer::~WarpRenderer() {
     delete textureShader;
 }
 
-QOpenGLFramebufferObject *WarpRenderer::createFramebufferObject(const QSize &size) {
-    QOpenGLFramebufferObjectFormat format;
-    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    format.setSamples(8);
-    return new QOpenGLFramebufferObject(size, format);
-}
-
 void WarpRenderer::synchronize(QQuickFramebufferObject *item) {
+    ThumbnailRenderer::synchronize(item);
     WarpObject *warpItem = static_cast<WarpObject*>(item);
     if(warpItem->resUpdated) {
         warpItem->resUpdated = false;
@@ -192,7 +177,7 @@ void WarpRenderer::synchronize(QQuickFramebufferObject *item) {
     }
 }
 
-void WarpRenderer::render() {
+void WarpRenderer::renderPreview() {
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
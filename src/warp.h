@@ -22,11 +22,11 @@
 #ifndef WARP_H
 #define WARP_H
 
-#include <QQuickFramebufferObject>
+#include "thumbnail.h"
 #include <QOpenGLFunctions_4_4_Core>
 #include <QOpenGLShaderProgram>
 
-class WarpObject: public QQuickFramebufferObject
+class WarpObject: public ThumbnailObject
 {
     Q_OBJECT
 public:
@@ -62,13 +62,12 @@ private:
     float m_intensity = 0.1f;
 };
 
-class WarpRenderer: public QQuickFramebufferObject::Renderer, public QOpenGLFunctions_4_4_Core {
+class WarpRenderer: public ThumbnailRenderer, public QOpenGLFunctions_4_4_Core {
 public:
     WarpRenderer(QVector2D res);
     ~WarpRenderer();
-    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size);
     void synchronize(QQuickFramebufferObject *item);
-    void render();
+    void renderPreview();
 private:
     void createWarp();
     void updateTexResolution();
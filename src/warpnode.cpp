@@ -38,12 +38,7 @@ WarpNode::WarpNode(QQuickItem *parent, QVector2D resolution, float intensity): N
     connect(this, &Node::changeResolution, preview, &WarpObject::setResolution);
     connect(this, &WarpNode::intensityChanged, preview, &WarpObject::setIntensity);
     connect(preview, &WarpObject::updatePreview, this, &WarpNode::updatePreview);
-    propView = new QQuickView();
-    propView->setSource(QUrl(QStringLiteral("qrc:/qml/WarpProperty.qml")));
-    propertiesPanel = qobject_cast<QQuickItem*>(propView->rootObject());
-    propertiesPanel->setProperty("startIntensity", m_intensity);
-    connect(propertiesPanel, SIGNAL(intensityChanged(qreal)), this, SLOT(updateIntensity(qreal)));
-    connect(propertiesPanel, SIGNAL(propertyChangingFinished(QString, QVariant, QVariant)), this, SLOT(propertyChanged(QString, QVariant, QVariant)));
+    propertiesPanelSource = QUrl(QStringLiteral("qrc:/qml/WarpProperty.qml"));
     createSockets(3, 1);
     setTitle("Warp");
     m_socketsInput[0]->setTip("Source");
@@ -55,6 +50,11 @@ WarpNode::~WarpNode() {
     delete preview;
 }
 
+void WarpNode::setupPropertyPanel() {
+    propertiesPanel->setProperty("startIntensity", m_intensity);
+    connect(propertiesPanel, SIGNAL(intensityChanged(qreal)), this, SLOT(updateIntensity(qreal)));
+}
+
 void WarpNode::operation() {
     preview->selectedItem = selected();
     preview->setSourceTexture(m_socketsInput[0]->value().toUInt());
@@ -71,6 +71,10 @@ void WarpNode::saveTexture(QString fileName) {
     preview->saveTexture(fileName);
 }
 
+bool WarpNode::costlyOperation() const {
+    return true;
+}
+
 void WarpNode::serialize(QJsonObject &json) const{
     Node::serialize(json);
     json["type"] = 18;
@@ -80,9 +84,8 @@ void WarpNode::serialize(QJsonObject &json) const{
 void WarpNode::deserialize(const QJsonObject &json, QHash<QUuid, Socket *> &hash) {
     Node::deserialize(json, hash);
     if(json.contains("intensity")) {
-        m_intensity = json["intensity"].toVariant().toFloat();
+        setIntensity(json["intensity"].toVariant().toFloat());
     }
-    propertiesPanel->setProperty("startIntensity", m_intensity);
 }
 
 float WarpNode::intensity() {
@@ -111,6 +114,6 @@ void WarpNode::setOutput() {
 
 void WarpNode::updateIntensity(qreal intensity) {
     setIntensity(intensity);
-    operation();
+    requestOperation();
     dataChanged();
 }